@@ -14,12 +14,18 @@ This package provides a the user-facing python part of libsemigroups_pybind11
 
 from _libsemigroups_pybind11 import (
     ToddCoxeter,
+    Kambites,
     KnuthBendix,
     Bipartition,
     PBR,
+    PackedBipartition,
+    PackedBMat,
+    PackedPBR,
     Congruence,
     FpSemigroup,
     ActionDigraph,
+    Presentation,
+    Sims1,
     congruence_kind,
     ReportGuard,
     add_cycle,
@@ -38,3 +44,8 @@ from _libsemigroups_pybind11 import (
 from .transf import Transf
 from .matrix import Matrix, MatrixKind, make_identity
 from .froidure_pin import FroidurePin
+from .element_array import ElementArray
+from .element_set import ElementSet, ElementDict
+from .action import RightAction, LeftAction
+from .cache import PresentationCache, canonical_form, presentation_hash
+from . import presentation
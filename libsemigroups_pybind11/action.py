@@ -0,0 +1,107 @@
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+# pylint: disable=no-name-in-module, invalid-name
+
+"""
+This package provides the user-facing python part of libsemigroups_pybind11 for
+actions.
+"""
+
+from _libsemigroups_pybind11 import (
+    Transf16,
+    Transf1,
+    Transf2,
+    Transf4,
+    PPerm16,
+    PPerm1,
+    PPerm2,
+    PPerm4,
+    Perm16,
+    Perm1,
+    Perm2,
+    Perm4,
+    BMat8,
+    RightActionTransf16UInt8,
+    RightActionTransf1UInt8,
+    RightActionTransf2UInt16,
+    RightActionTransf4UInt32,
+    RightActionPerm16UInt8,
+    RightActionPerm1UInt8,
+    RightActionPerm2UInt16,
+    RightActionPerm4UInt32,
+    RightActionPPerm16PPerm16,
+    RightActionPPerm1PPerm1,
+    RightActionPPerm2PPerm2,
+    RightActionPPerm4PPerm4,
+    LeftActionPPerm16PPerm16,
+    LeftActionPPerm1PPerm1,
+    LeftActionPPerm2PPerm2,
+    LeftActionPPerm4PPerm4,
+    RightActionBMat8BMat8,
+    LeftActionBMat8BMat8,
+)
+
+_RightAction = {
+    (Transf16, int): RightActionTransf16UInt8,
+    (Transf1, int): RightActionTransf1UInt8,
+    (Transf2, int): RightActionTransf2UInt16,
+    (Transf4, int): RightActionTransf4UInt32,
+    (Perm16, int): RightActionPerm16UInt8,
+    (Perm1, int): RightActionPerm1UInt8,
+    (Perm2, int): RightActionPerm2UInt16,
+    (Perm4, int): RightActionPerm4UInt32,
+    (PPerm16, PPerm16): RightActionPPerm16PPerm16,
+    (PPerm1, PPerm1): RightActionPPerm1PPerm1,
+    (PPerm2, PPerm2): RightActionPPerm2PPerm2,
+    (PPerm4, PPerm4): RightActionPPerm4PPerm4,
+    (BMat8, BMat8): RightActionBMat8BMat8,
+}
+
+_LeftAction = {
+    (PPerm16, PPerm16): LeftActionPPerm16PPerm16,
+    (PPerm1, PPerm1): LeftActionPPerm1PPerm1,
+    (PPerm2, PPerm2): LeftActionPPerm2PPerm2,
+    (PPerm4, PPerm4): LeftActionPPerm4PPerm4,
+    (BMat8, BMat8): LeftActionBMat8BMat8,
+}
+
+
+def _make_action(actions, side, gens, seeds):
+    if len(gens) == 0 or len(seeds) == 0:
+        raise ValueError("expected at least 1 generator and at least 1 seed")
+    key = (type(gens[0]), type(seeds[0]))
+    if key not in actions:
+        raise TypeError(
+            f"there is no {side} action of {key[0].__name__} on "
+            f"{key[1].__name__}"
+        )
+    result = actions[key]()
+    for x in gens:
+        result.add_generator(x)
+    for pt in seeds:
+        result.add_seed(pt)
+    return result
+
+
+def RightAction(gens, seeds):
+    """
+    Construct the right action of the semigroup generated by ``gens`` on the
+    points ``seeds``, the type of which is determined by the types of the
+    generators and seeds.
+    """
+    return _make_action(_RightAction, "right", gens, seeds)
+
+
+def LeftAction(gens, seeds):
+    """
+    Construct the left action of the semigroup generated by ``gens`` on the
+    points ``seeds``, the type of which is determined by the types of the
+    generators and seeds.
+    """
+    return _make_action(_LeftAction, "left", gens, seeds)
@@ -0,0 +1,456 @@
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+# pylint: disable=no-name-in-module, invalid-name
+
+"""
+This package provides the user-facing python part of libsemigroups_pybind11 for
+caching the results of computations with presentations on disk.
+"""
+
+import hashlib
+import itertools
+import json
+import math
+import os
+import tempfile
+
+from _libsemigroups_pybind11 import (
+    POSITIVE_INFINITY,
+    FpSemigroup,
+    KnuthBendix,
+    ToddCoxeter,
+    congruence_kind,
+)
+
+# The version of the format of the canonical form and of the cache files,
+# this must be incremented whenever either of these changes.
+_VERSION = 1
+
+# The maximum number of relabellings of the alphabet tried when computing the
+# canonical form of a presentation.
+_MAX_RELABELLINGS = 5040
+
+
+def _shortlex_key(w):
+    return (len(w), tuple(w))
+
+
+def _rules(p):
+    # The rules of p with letters replaced by their indices in the alphabet.
+    index = {a: i for i, a in enumerate(p.alphabet())}
+    rules = p.rules
+    return [
+        ([index[a] for a in rules[i]], [index[a] for a in rules[i + 1]])
+        for i in range(0, len(rules), 2)
+    ]
+
+
+def _relabel(rules, perm):
+    # Returns the rules with every letter a replaced by perm[a], each rule
+    # oriented so that its shortlex greater side is first, trivial and
+    # duplicate rules removed, and the rules sorted.
+    result = set()
+    for u, v in rules:
+        u, v = tuple(perm[a] for a in u), tuple(perm[a] for a in v)
+        if _shortlex_key(u) < _shortlex_key(v):
+            u, v = v, u
+        if u != v:
+            result.add((u, v))
+    return sorted(
+        result, key=lambda r: (_shortlex_key(r[0]), _shortlex_key(r[1]))
+    )
+
+
+def _letter_invariant(rules, a):
+    # A value depending only on the position of a in the presentation up to
+    # relabelling, used to restrict the relabellings which must be tried.
+    counts = []
+    for u, v in rules:
+        cu, cv = u.count(a), v.count(a)
+        if (len(u), cu) < (len(v), cv):
+            u, v, cu, cv = v, u, cv, cu
+        if cu + cv != 0:
+            counts.append((len(u), len(v), cu, cv))
+    return (sum(c[2] + c[3] for c in counts), tuple(sorted(counts)))
+
+
+def _relabellings(n, rules):
+    # Yields the relabellings of the alphabet respecting the invariants of the
+    # letters. If there are too many such relabellings, only one is yielded,
+    # in which case the canonical form is only invariant under reordering the
+    # rules and their sides.
+    invariants = [_letter_invariant(rules, a) for a in range(n)]
+    cells = []
+    for inv in sorted(set(invariants)):
+        cells.append([a for a in range(n) if invariants[a] == inv])
+
+    number_of_relabellings = 1
+    for c in cells:
+        number_of_relabellings *= math.factorial(len(c))
+    if number_of_relabellings > _MAX_RELABELLINGS:
+        cells = [[a] for c in cells for a in c]
+
+    perms = (itertools.permutations(c) for c in cells)
+    for choice in itertools.product(*perms):
+        perm = [0] * n
+        for i, a in enumerate(itertools.chain(*choice)):
+            perm[a] = i
+        yield perm
+
+
+def _kind_name(kind):
+    return {
+        congruence_kind.left: "left",
+        congruence_kind.right: "right",
+        congruence_kind.twosided: "twosided",
+    }[kind]
+
+
+def canonical_form(p, kind=congruence_kind.twosided):
+    """
+    Returns a canonical form for the presentation ``p`` and the congruence kind
+    ``kind``.
+
+    The canonical form is a ``dict`` with keys ``"kind"``,
+    ``"number_of_letters"``, ``"contains_empty_word"``, and ``"rules"``, where
+    the letters are ``0, ..., n - 1``, every rule ``u = v`` has ``u`` shortlex
+    greater than ``v``, and the rules are sorted, without duplicates or
+    trivial rules. Two presentations that are equal up to relabelling their
+    alphabets, reordering their rules, reordering the sides of their rules,
+    or removing duplicate and trivial rules, have the same canonical form.
+    This is guaranteed if the letters that cannot be distinguished by how
+    often, and in which rules, they occur allow at most 5040 relabellings;
+    otherwise the canonical form is only invariant under the operations on
+    rules.
+
+    :param p: the presentation.
+    :type p: Presentation
+    :param kind: the kind of congruence.
+    :type kind: congruence_kind
+
+    :return: A ``dict``.
+    """
+    form, _ = _canonical_form(p, kind)
+    return form
+
+
+def _canonical_form(p, kind):
+    p.validate()
+    n = len(p.alphabet())
+    # The invariants of the letters are computed from the normalised rules,
+    # so that they do not depend on duplicate rules, for example.
+    rules = _relabel(_rules(p), list(range(n)))
+    best, best_perm = None, None
+    for perm in _relabellings(n, rules):
+        candidate = _relabel(rules, perm)
+        key = [(_shortlex_key(u), _shortlex_key(v)) for u, v in candidate]
+        if best is None or key < best[0]:
+            best, best_perm = (key, candidate), perm
+    form = {
+        "kind": _kind_name(kind),
+        "number_of_letters": n,
+        "contains_empty_word": p.contains_empty_word(),
+        "rules": [[list(u), list(v)] for u, v in best[1]],
+    }
+    return form, best_perm
+
+
+def presentation_hash(p, kind=congruence_kind.twosided):
+    """
+    Returns a hash of the presentation ``p`` and congruence kind ``kind``,
+    which is the SHA-256 digest of its :py:func:`canonical_form`. The value is
+    stable across processes, machines and versions of Python.
+
+    :param p: the presentation.
+    :type p: Presentation
+    :param kind: the kind of congruence.
+    :type kind: congruence_kind
+
+    :return: A ``str`` of 64 hexadecimal digits.
+    """
+    return _hash(canonical_form(p, kind))
+
+
+def _hash(form):
+    data = json.dumps(
+        {"version": _VERSION, "presentation": form},
+        sort_keys=True,
+        separators=(",", ":"),
+    )
+    return hashlib.sha256(data.encode("utf-8")).hexdigest()
+
+
+def _default_directory():
+    if "LIBSEMIGROUPS_PYBIND11_CACHE" in os.environ:
+        return os.environ["LIBSEMIGROUPS_PYBIND11_CACHE"]
+    return os.path.join(
+        os.environ.get(
+            "XDG_CACHE_HOME", os.path.join(os.path.expanduser("~"), ".cache")
+        ),
+        "libsemigroups_pybind11",
+    )
+
+
+def _semigroup_pairs(form):
+    # Returns the number of generators and the rules of a semigroup
+    # presentation for the canonical form. If the empty word is allowed, then
+    # a new generator, the last one, is added for the identity.
+    n = form["number_of_letters"]
+    rules = [(list(u), list(v)) for u, v in form["rules"]]
+    if not form["contains_empty_word"]:
+        return n, rules
+    e = n
+    rules = [(u if u else [e], v if v else [e]) for u, v in rules]
+    rules.extend(([a, e], [a]) for a in range(n))
+    rules.extend(([e, a], [a]) for a in range(n))
+    rules.append(([e, e], [e]))
+    return n + 1, rules
+
+
+def _inverse(perm):
+    result = [0] * len(perm)
+    for a, b in enumerate(perm):
+        result[b] = a
+    return result
+
+
+class PresentationCache:
+    """
+    An on-disk cache of the results of computations with presentations, keyed
+    by :py:func:`presentation_hash`, so that the same presentation, up to
+    relabelling its alphabet and reordering its rules, is only ever
+    enumerated once.
+
+    Every presentation is stored in a separate ``json`` file in
+    :py:attr:`directory`, containing its canonical form and, for those that
+    have been computed, its size, a confluent rewriting system, and a coset
+    table. Results are stored in terms of the canonical form, and translated
+    back into the alphabet of the presentation when they are retrieved.
+
+    If a presentation allows the empty word, then the rules and coset tables
+    are for the semigroup presentation where the identity is the additional
+    generator with index ``len(p.alphabet())``.
+    """
+
+    def __init__(self, directory=None):
+        """
+        Construct a cache in ``directory``, which is created if it does not
+        exist. If ``directory`` is ``None``, then the value of the environment
+        variable ``LIBSEMIGROUPS_PYBIND11_CACHE`` is used, or if this is not
+        set, ``~/.cache/libsemigroups_pybind11``.
+
+        :param directory: the directory.
+        :type directory: str
+        """
+        if directory is None:
+            directory = _default_directory()
+        self._directory = directory
+        os.makedirs(directory, exist_ok=True)
+
+    @property
+    def directory(self):
+        """
+        The directory containing the cache files.
+        """
+        return self._directory
+
+    def _path(self, key):
+        return os.path.join(self._directory, key + ".json")
+
+    def _load(self, key):
+        try:
+            with open(self._path(key), "r", encoding="utf-8") as file:
+                return json.load(file)
+        except (OSError, ValueError):
+            # Missing, or partially written by a killed process
+            return None
+
+    def _store(self, key, entry):
+        # Write to a temporary file and rename, so that concurrent jobs never
+        # see a partially written entry.
+        fd, tmp = tempfile.mkstemp(dir=self._directory, suffix=".tmp")
+        try:
+            with os.fdopen(fd, "w", encoding="utf-8") as file:
+                json.dump(entry, file)
+            os.replace(tmp, self._path(key))
+        except BaseException:
+            os.unlink(tmp)
+            raise
+
+    def _entry(self, p, kind):
+        form, perm = _canonical_form(p, kind)
+        key = _hash(form)
+        entry = self._load(key)
+        if entry is None or entry.get("presentation") != form:
+            entry = {"presentation": form}
+        # perm maps letters of p to letters of form, the identity (if any) is
+        # fixed.
+        perm = list(perm) + [len(perm)]
+        return key, entry, perm
+
+    def __contains__(self, p):
+        return os.path.exists(self._path(presentation_hash(p)))
+
+    def __len__(self):
+        files = os.listdir(self._directory)
+        return sum(1 for f in files if f.endswith(".json"))
+
+    def clear(self):
+        """
+        Remove every entry from the cache.
+
+        :return: None
+        """
+        for f in os.listdir(self._directory):
+            if f.endswith(".json"):
+                os.unlink(os.path.join(self._directory, f))
+
+    def size(self, p, kind=congruence_kind.twosided):
+        """
+        Returns the number of classes of the congruence of kind ``kind``
+        defined by the presentation ``p``, i.e. the size of the semigroup or
+        monoid if ``kind`` is ``congruence_kind.twosided``. The value is
+        looked up in the cache, and computed using :py:class:`ToddCoxeter`
+        and stored if it is not there. If the number of classes is obviously
+        infinite, then :py:obj:`POSITIVE_INFINITY` is stored and returned
+        without running :py:class:`ToddCoxeter`; otherwise, if the number of
+        classes is infinite, then this function does not return.
+
+        :param p: the presentation.
+        :type p: Presentation
+        :param kind: the kind of congruence.
+        :type kind: congruence_kind
+
+        :return: An ``int`` or :py:obj:`POSITIVE_INFINITY`.
+        """
+        _, entry, _ = self._entry(p, kind)
+        if "size" not in entry:
+            self._coset_table(entry, kind)
+        return entry["size"]
+
+    def coset_table(self, p, kind=congruence_kind.twosided):
+        """
+        Returns the coset table of the congruence of kind ``kind`` defined by
+        the presentation ``p``, computed using :py:class:`ToddCoxeter` if it
+        is not in the cache. The entry in row ``c`` and column ``a`` is the
+        index of the class of ``w a`` (or ``a w`` if ``kind`` is
+        ``congruence_kind.left``), where ``w`` is any word in class ``c``, and
+        ``a`` is the index of a letter in ``p.alphabet()``. As for
+        :py:meth:`size`, this function does not return if the number of
+        classes is infinite, but not obviously infinite.
+
+        :param p: the presentation.
+        :type p: Presentation
+        :param kind: the kind of congruence.
+        :type kind: congruence_kind
+
+        :return: A ``List[List[int]]``.
+
+        :raises ValueError: if the number of classes is obviously infinite.
+        """
+        _, entry, perm = self._entry(p, kind)
+        if "size" not in entry:
+            self._coset_table(entry, kind)
+        if entry["size"] == POSITIVE_INFINITY:
+            raise ValueError("the number of classes is infinite")
+        n = len(p.alphabet()) + int(p.contains_empty_word())
+        return [[row[perm[a]] for a in range(n)] for row in entry["table"]]
+
+    def _coset_table(self, entry, kind):
+        n, rules = _semigroup_pairs(entry["presentation"])
+        tc = ToddCoxeter(kind)
+        tc.set_number_of_generators(n)
+        for u, v in rules:
+            tc.add_pair(u, v)
+        if tc.is_quotient_obviously_infinite():
+            # There is no coset table to store, and number_of_classes would
+            # never return.
+            entry["size"] = POSITIVE_INFINITY
+            self._store(_hash(entry["presentation"]), entry)
+            return
+        entry["size"] = tc.number_of_classes()
+        table = []
+        for c in range(entry["size"]):
+            w = tc.class_index_to_word(c)
+            if kind == congruence_kind.left:
+                row = [tc.word_to_class_index([a] + w) for a in range(n)]
+            else:
+                row = [tc.word_to_class_index(w + [a]) for a in range(n)]
+            table.append(row)
+        entry["table"] = table
+        self._store(_hash(entry["presentation"]), entry)
+
+    def knuth_bendix(self, p):
+        """
+        Returns a :py:class:`KnuthBendix` instance for the presentation ``p``.
+        If a confluent rewriting system for ``p`` is in the cache, then its
+        rules, translated into the alphabet of ``p``, are used to define the
+        returned instance. Otherwise the rules of ``p`` are used, the instance
+        is run to completion, and its active rules are stored in the cache.
+
+        The rules in the cache are confluent with respect to the order of the
+        letters in the :py:func:`canonical_form` of ``p``. If the letters of
+        ``p`` are in a different order, then the translated rules need not be
+        reduced or confluent, and so the returned instance may have to be
+        run. This is usually much quicker than running it on the rules of
+        ``p``.
+
+        :param p: the presentation.
+        :type p: Presentation
+
+        :return: A :py:class:`KnuthBendix` instance.
+        """
+        key, entry, perm = self._entry(p, congruence_kind.twosided)
+        if "rules" in entry:
+            inv = _inverse(perm)
+            kb = KnuthBendix()
+            kb.set_alphabet(len(perm) - 1 + int(p.contains_empty_word()))
+            for u, v in entry["rules"]:
+                kb.add_rule([inv[a] for a in u], [inv[a] for a in v])
+            return kb
+
+        n, rules = _semigroup_pairs(entry["presentation"])
+        kb = KnuthBendix()
+        kb.set_alphabet(n)
+        for u, v in rules:
+            kb.add_rule(u, v)
+        kb.run()
+        entry["rules"] = [
+            [kb.string_to_word(u), kb.string_to_word(v)]
+            for u, v in kb.active_rules()
+        ]
+        self._store(key, entry)
+        return self.knuth_bendix(p)
+
+    def fpsemigroup(self, p):
+        """
+        Returns an :py:class:`FpSemigroup` instance for the presentation
+        ``p``. If a confluent rewriting system for ``p`` is in the cache, then
+        it is used as the rules of the returned instance, so that the
+        :py:class:`KnuthBendix` instance it runs terminates immediately.
+
+        :param p: the presentation.
+        :type p: Presentation
+
+        :return: A :py:class:`FpSemigroup` instance.
+        """
+        _, entry, perm = self._entry(p, congruence_kind.twosided)
+        S = FpSemigroup()
+        if "rules" in entry:
+            kb = self.knuth_bendix(p)
+            S.set_alphabet(kb.alphabet())
+            for u, v in kb.rules():
+                S.add_rule(u, v)
+            return S
+        n, rules = _semigroup_pairs(entry["presentation"])
+        inv = _inverse(perm)
+        S.set_alphabet(n)
+        for u, v in rules:
+            S.add_rule([inv[a] for a in u], [inv[a] for a in v])
+        return S
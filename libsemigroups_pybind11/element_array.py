@@ -0,0 +1,48 @@
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+# pylint: disable=no-name-in-module, invalid-name
+
+"""
+This package provides the user-facing python part of libsemigroups_pybind11
+relating to arrays of elements.
+"""
+
+from .froidure_pin import _ArrayTypes
+
+_ElementToArray = {T.element_type: T for T in _ArrayTypes}
+
+
+def ElementArray(x):
+    """
+    Construct an array of elements, which are stored contiguously in a single
+    block of memory. The type of the array is determined by the type of the
+    elements.
+
+    :param x:
+      a non-empty list of elements, a :py:class:`FroidurePin` instance, whose
+      generators are copied, or another array, which is copied.
+    :type x: list
+
+    :return: An array, such as a ``Transf1Array`` or a ``BipartitionArray``.
+
+    :raises ValueError: if ``x`` is an empty list.
+    :raises TypeError: if there is no array type for the elements of ``x``.
+    """
+    if isinstance(x, list):
+        if len(x) == 0:
+            raise ValueError("expected a non-empty list")
+        element_type = type(x[0])
+    else:
+        element_type = getattr(type(x), "element_type", None)
+    if element_type not in _ElementToArray:
+        raise TypeError(
+            "expected a list of elements, a FroidurePin instance or an "
+            f"array, found {type(x).__name__}"
+        )
+    return _ElementToArray[element_type](x)
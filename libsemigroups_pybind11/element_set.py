@@ -0,0 +1,128 @@
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+# pylint: disable=no-name-in-module, invalid-name
+
+"""
+This package provides the user-facing python part of libsemigroups_pybind11
+relating to sets and dictionaries of elements.
+"""
+
+import _libsemigroups_pybind11
+
+_ElementTypeNames = (
+    "Transf16",
+    "Transf1",
+    "Transf2",
+    "Transf4",
+    "PPerm16",
+    "PPerm1",
+    "PPerm2",
+    "PPerm4",
+    "Perm16",
+    "Perm1",
+    "Perm2",
+    "Perm4",
+    "Bipartition",
+    "PBR",
+    "BMat8",
+    "PackedBMat",
+    "PackedPBR",
+    "PackedBipartition",
+    "BMat",
+    "IntMat",
+    "MaxPlusMat",
+    "MinPlusMat",
+    "ProjMaxPlusMat",
+    "MaxPlusTruncMat",
+    "MinPlusTruncMat",
+    "NTPMat",
+) + tuple(
+    # The matrices whose dimension is known at compile time, see matrix.py.
+    f"{name}{n}"
+    for name in ("BMat", "IntMat", "MaxPlusMat", "MinPlusMat")
+    for n in range(2, 7)
+)
+
+_ElementToSet = {
+    getattr(_libsemigroups_pybind11, name): getattr(
+        _libsemigroups_pybind11, name + "Set"
+    )
+    for name in _ElementTypeNames
+}
+
+_ElementToDict = {
+    getattr(_libsemigroups_pybind11, name): getattr(
+        _libsemigroups_pybind11, name + "Dict"
+    )
+    for name in _ElementTypeNames
+}
+
+
+def _element_type(x):
+    if isinstance(x, type):
+        return x
+    if isinstance(x, (list, dict)):
+        if len(x) == 0:
+            raise ValueError(f"expected a non-empty {type(x).__name__}")
+        return type(next(iter(x)))
+    return getattr(type(x), "element_type", None)
+
+
+def ElementSet(x):
+    """
+    Construct a set of elements, which are hashed and compared in C++. The
+    type of the set is determined by the type of the elements.
+
+    :param x:
+      an element type, such as ``Transf1``, a non-empty list of elements, or
+      an array of elements, see :py:func:`ElementArray`.
+    :type x: type
+
+    :return: A set, such as a ``Transf1Set`` or a ``BipartitionSet``.
+
+    :raises ValueError: if ``x`` is an empty list.
+    :raises TypeError: if there is no set type for the elements of ``x``.
+    """
+    element_type = _element_type(x)
+    if element_type not in _ElementToSet:
+        raise TypeError(
+            "expected an element type, a list of elements or an array, "
+            f"found {type(x).__name__}"
+        )
+    if isinstance(x, type):
+        return _ElementToSet[element_type]()
+    return _ElementToSet[element_type](x)
+
+
+def ElementDict(x):
+    """
+    Construct a dictionary whose keys are elements, which are hashed and
+    compared in C++. The type of the dictionary is determined by the type of
+    the keys.
+
+    :param x:
+      an element type, such as ``Transf1``, or a non-empty ``dict`` whose
+      items are copied.
+    :type x: type
+
+    :return: A dictionary, such as a ``Transf1Dict`` or a ``BipartitionDict``.
+
+    :raises ValueError: if ``x`` is an empty ``dict``.
+    :raises TypeError: if there is no dictionary type for the keys of ``x``.
+    """
+    element_type = _element_type(x)
+    if element_type not in _ElementToDict or isinstance(x, list):
+        raise TypeError(
+            f"expected an element type or a dict, found {type(x).__name__}"
+        )
+    result = _ElementToDict[element_type]()
+    if isinstance(x, dict):
+        for key, val in x.items():
+            result[key] = val
+    return result
@@ -13,6 +13,8 @@ This package provides the user-facing python part of libsemigroups_pybind11 for
 FroidurePin.
 """
 
+import _libsemigroups_pybind11
+
 from _libsemigroups_pybind11 import (
     Transf16,
     Transf1,
@@ -48,6 +50,12 @@ from _libsemigroups_pybind11 import (
     FroidurePinBMat8,
     BMat,
     FroidurePinBMat,
+    PackedBMat,
+    FroidurePinPackedBMat,
+    PackedPBR,
+    FroidurePinPackedPBR,
+    PackedBipartition,
+    FroidurePinPackedBipartition,
     IntMat,
     FroidurePinIntMat,
     MaxPlusMat,
@@ -81,6 +89,9 @@ _ElementToFroidurePin = {
     PBR: FroidurePinPBR,
     BMat8: FroidurePinBMat8,
     BMat: FroidurePinBMat,
+    PackedBMat: FroidurePinPackedBMat,
+    PackedPBR: FroidurePinPackedPBR,
+    PackedBipartition: FroidurePinPackedBipartition,
     IntMat: FroidurePinIntMat,
     MaxPlusMat: FroidurePinMaxPlusMat,
     MinPlusMat: FroidurePinMinPlusMat,
@@ -90,6 +101,13 @@ _ElementToFroidurePin = {
     NTPMat: FroidurePinNTPMat,
 }
 
+# The matrices whose dimension is known at compile time, see matrix.py.
+for _name in ("BMat", "IntMat", "MaxPlusMat", "MinPlusMat"):
+    for _n in range(2, 7):
+        _ElementToFroidurePin[
+            getattr(_libsemigroups_pybind11, f"{_name}{_n}")
+        ] = getattr(_libsemigroups_pybind11, f"FroidurePin{_name}{_n}")
+
 _FroidurePinTypes = {
     FroidurePinTransf16: True,
     FroidurePinTransf1: True,
@@ -107,6 +125,9 @@ _FroidurePinTypes = {
     FroidurePinPBR: True,
     FroidurePinBMat8: True,
     FroidurePinBMat: True,
+    FroidurePinPackedBMat: True,
+    FroidurePinPackedPBR: True,
+    FroidurePinPackedBipartition: True,
     FroidurePinIntMat: True,
     FroidurePinMaxPlusMat: True,
     FroidurePinMinPlusMat: True,
@@ -118,6 +139,26 @@ _FroidurePinTypes = {
     FroidurePinTCE: True,
 }
 
+for _FroidurePinType in _ElementToFroidurePin.values():
+    _FroidurePinTypes[_FroidurePinType] = True
+
+_ArrayTypes = {
+    getattr(_libsemigroups_pybind11, f"{_name}Array"): True
+    for _name in (
+        "Transf1",
+        "Transf2",
+        "Transf4",
+        "PPerm1",
+        "PPerm2",
+        "PPerm4",
+        "Perm1",
+        "Perm2",
+        "Perm4",
+        "Bipartition",
+        "PBR",
+    )
+}
+
 
 def FroidurePin(*args):
     """
@@ -127,6 +168,8 @@ def FroidurePin(*args):
         raise ValueError("expected at least 1 argument, found 0")
     if type(args[0]) in _FroidurePinTypes:
         return type(args[0])(args[0])
+    if type(args[0]) in _ArrayTypes:
+        return args[0].froidure_pin()
     if isinstance(args[0], list):
         args_ = args[0]
         type_ = type(args_[0])
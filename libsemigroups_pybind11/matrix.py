@@ -15,6 +15,8 @@ relating to matrices.
 
 from enum import Enum
 
+import _libsemigroups_pybind11
+
 from _libsemigroups_pybind11 import (
     BMat,
     IntMat,
@@ -54,26 +56,99 @@ _Matrix = {
     MatrixKind.NTP: NTPMat,
 }
 
+# The types of the n x n matrices whose dimension is known at compile time,
+# which are used by Matrix, make, and make_identity when the dimension is one
+# of these.
+_STATIC_DIMENSIONS = range(2, 7)
+
+_StaticMatrix = {
+    (kind, n): getattr(_libsemigroups_pybind11, _Matrix[kind].__name__ + str(n))
+    for kind in (
+        MatrixKind.Boolean,
+        MatrixKind.Integer,
+        MatrixKind.MaxPlus,
+        MatrixKind.MinPlus,
+    )
+    for n in _STATIC_DIMENSIONS
+}
+
+
+def _dimension(args):
+    # Returns n if args are the arguments for constructing an n x n matrix
+    # (other than a copy), and None otherwise.
+    if len(args) == 2 and all(isinstance(x, int) for x in args):
+        return args[0] if args[0] == args[1] else None
+    if len(args) != 1:
+        return None
+    rows = args[0]
+    if isinstance(rows, list):
+        if all(
+            isinstance(row, (list, tuple)) and len(row) == len(rows)
+            for row in rows
+        ):
+            return len(rows)
+    elif hasattr(rows, "shape") and len(rows.shape) == 2:
+        return rows.shape[0] if rows.shape[0] == rows.shape[1] else None
+    return None
+
+
+def _matrix_type(kind: MatrixKind, args):
+    return _StaticMatrix.get((kind, _dimension(args)), _Matrix[kind])
+
 
 def Matrix(kind: MatrixKind, *args):
     """
     Constructs a matrix, basically just delegates to
-    _libsemigroups_pybind11
+    _libsemigroups_pybind11. If the matrix is n x n for some small n, then a
+    matrix whose dimension is known at compile time is returned.
     """
     if not isinstance(kind, MatrixKind):
         raise TypeError("the 1st argument must be a MatrixKind")
-    return _Matrix[kind](*args)
+    if len(args) == 1 and type(args[0]) in _StaticMatrix.values():
+        # A copy, the type of the copy must be consistent with kind
+        x = args[0]
+        if type(x) is not _StaticMatrix.get((kind, x.number_of_rows())):
+            raise TypeError(
+                f"expected a matrix of kind {kind}, found {type(x).__name__}"
+            )
+        return type(x)(x)
+    return _matrix_type(kind, args)(*args)
 
 
 def make_identity(kind: MatrixKind, *args) -> Matrix:
     """
-    Construct the identity matrix of the appropriate type.
+    Construct the identity matrix of the appropriate type, which is the same
+    as the type of the matrix returned by :py:class:`Matrix`.
     """
+    if len(args) == 1:
+        return _matrix_type(kind, args * 2).make_identity(*args)
     return _Matrix[kind].make_identity(*args)
 
 
 def make(kind: MatrixKind, *args) -> Matrix:
     """
-    Construct a matrix of the appropriate type.
+    Construct and validate a matrix of the appropriate type, which is the
+    same as the type of the matrix returned by :py:class:`Matrix`.
+    """
+    return _matrix_type(kind, args).make(*args)
+
+
+def products(xs, ys, number_of_threads=1):
+    """
+    Returns the list of the products ``xs[i] * ys[i]``, computed in parallel
+    using ``number_of_threads`` threads.
+    """
+    if len(xs) == 0 and len(ys) == 0:
+        return []
+    T = type(xs[0]) if len(xs) != 0 else type(ys[0])
+    return T.products(list(xs), list(ys), number_of_threads)
+
+
+def product(xs, number_of_threads=1):
+    """
+    Returns the product ``xs[0] * xs[1] * ...``, computed in parallel using
+    ``number_of_threads`` threads.
     """
-    return _Matrix[kind].make(*args)
+    if len(xs) == 0:
+        raise ValueError("expected a non-empty list of matrices")
+    return type(xs[0]).product(list(xs), number_of_threads)
@@ -0,0 +1,378 @@
+# -*- coding: utf-8 -*-
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+# pylint: disable=no-name-in-module, invalid-name
+
+"""
+This package provides the user-facing python part of libsemigroups_pybind11 for
+simplifying presentations using Tietze transformations.
+"""
+
+from _libsemigroups_pybind11 import Presentation
+
+
+def _pairs(p):
+    rules = p.rules
+    return [
+        (list(rules[i]), list(rules[i + 1])) for i in range(0, len(rules), 2)
+    ]
+
+
+def _flatten(pairs):
+    return [w for rule in pairs for w in rule]
+
+
+def _replace_letter(word, a, w):
+    result = []
+    for x in word:
+        if x == a:
+            result.extend(w)
+        else:
+            result.append(x)
+    return result
+
+
+def _replace_subword(word, w, x):
+    # Replace the non-overlapping occurrences of w in word by the letter x,
+    # from left to right. If word is w, then replacing it would only result in
+    # the redundant rule x = y for some letter y, so word is left as it is.
+    if word == w:
+        return word
+    result, i, n = [], 0, len(w)
+    while i < len(word):
+        if word[i : i + n] == w:
+            result.append(x)
+            i += n
+        else:
+            result.append(word[i])
+            i += 1
+    return result
+
+
+def _count_subword(word, w):
+    # The number of occurrences of w in word replaced by _replace_subword.
+    if word == w:
+        return 0
+    count, i, n = 0, 0, len(w)
+    while i <= len(word) - n:
+        if word[i : i + n] == w:
+            count += 1
+            i += n
+        else:
+            i += 1
+    return count
+
+
+def _without_trivial_rules(pairs):
+    return [(u, v) for u, v in pairs if u != v]
+
+
+def _without_duplicate_rules(pairs):
+    result, seen = [], set()
+    for u, v in pairs:
+        key = tuple(sorted((tuple(u), tuple(v))))
+        if key not in seen:
+            seen.add(key)
+            result.append((u, v))
+    return result
+
+
+def _remove_trivial_and_duplicate_rules(pairs):
+    return _without_duplicate_rules(_without_trivial_rules(pairs))
+
+
+def _set_pairs(p, pairs):
+    p.rules = _flatten(pairs)
+
+
+def length(p):
+    """
+    Returns the sum of the lengths of the rules of the presentation ``p``.
+
+    :param p: the presentation.
+    :type p: Presentation
+
+    :return: An ``int``.
+    """
+    return sum(len(w) for w in p.rules)
+
+
+def remove_trivial_rules(p):
+    """
+    Remove the rules of the form ``u = u`` from the presentation ``p``.
+
+    :param p: the presentation.
+    :type p: Presentation
+
+    :return: None
+    """
+    _set_pairs(p, _without_trivial_rules(_pairs(p)))
+
+
+def remove_duplicate_rules(p):
+    """
+    Remove the duplicate rules from the presentation ``p``, where the rules
+    ``u = v`` and ``v = u`` are considered to be duplicates. The rules that
+    remain are in the same order as in ``p``.
+
+    :param p: the presentation.
+    :type p: Presentation
+
+    :return: None
+    """
+    _set_pairs(p, _without_duplicate_rules(_pairs(p)))
+
+
+class PresentationSimplification:
+    """
+    The result of simplifying a presentation using :py:func:`simplify`.
+
+    The simplified presentation is :py:attr:`presentation`, and the words in
+    the alphabets of the original and the simplified presentations can be
+    translated into each other using :py:meth:`to_simplified` and
+    :py:meth:`to_original`. Two words over the original alphabet are equal in
+    the semigroup or monoid defined by the original presentation if and only
+    if their images under :py:meth:`to_simplified` are equal in the one
+    defined by :py:attr:`presentation`.
+    """
+
+    def __init__(self, presentation, forward, backward):
+        self._presentation = presentation
+        self._forward = forward
+        self._backward = backward
+
+    @property
+    def presentation(self):
+        """
+        The simplified presentation, the alphabet of which is
+        ``[0, 1, ..., n - 1]`` for some ``n``.
+        """
+        return self._presentation
+
+    def to_simplified(self, word):
+        """
+        Translate a word over the alphabet of the original presentation into a
+        word over the alphabet of :py:attr:`presentation` representing the
+        same element.
+
+        :param word: the word to translate.
+        :type word: List[int]
+
+        :return: A ``List[int]``.
+
+        :raises ValueError:
+          if ``word`` contains a letter not in the original alphabet.
+        """
+        return self._translate(self._forward, word)
+
+    def to_original(self, word):
+        """
+        Translate a word over the alphabet of :py:attr:`presentation` into a
+        word over the alphabet of the original presentation representing the
+        same element.
+
+        :param word: the word to translate.
+        :type word: List[int]
+
+        :return: A ``List[int]``.
+
+        :raises ValueError:
+          if ``word`` contains a letter not in the simplified alphabet.
+        """
+        return self._translate(self._backward, word)
+
+    @staticmethod
+    def _translate(images, word):
+        result = []
+        for x in word:
+            if x not in images:
+                raise ValueError(
+                    f"the letter {x} does not belong to the alphabet"
+                )
+            result.extend(images[x])
+        return result
+
+    def __repr__(self):
+        return (
+            f"<presentation simplification with {len(self._forward)} -> "
+            f"{len(self._backward)} letters>"
+        )
+
+
+class _Simplifier:
+    def __init__(self, p):
+        p.validate()
+        self.alphabet = list(p.alphabet())
+        self.contains_empty_word = p.contains_empty_word()
+        self.pairs = _remove_trivial_and_duplicate_rules(_pairs(p))
+        self.forward = {a: [a] for a in self.alphabet}
+        self.backward = {a: [a] for a in self.alphabet}
+
+    def _elimination_candidate(self):
+        best = None
+        for i, (u, v) in enumerate(self.pairs):
+            for lhs, rhs in ((u, v), (v, u)):
+                if len(lhs) == 1 and lhs[0] not in rhs:
+                    if best is None or len(rhs) < len(best[2]):
+                        best = (i, lhs[0], rhs)
+        return best
+
+    def eliminate_generators(self):
+        while True:
+            candidate = self._elimination_candidate()
+            if candidate is None:
+                return
+            i, a, w = candidate
+            del self.pairs[i]
+            self.pairs = _remove_trivial_and_duplicate_rules(
+                [
+                    (_replace_letter(u, a, w), _replace_letter(v, a, w))
+                    for u, v in self.pairs
+                ]
+            )
+            self.alphabet.remove(a)
+            del self.backward[a]
+            for b, image in self.forward.items():
+                self.forward[b] = _replace_letter(image, a, w)
+
+    def _best_subword(self, min_length, max_length):
+        # Count the (possibly overlapping) occurrences of every subword of
+        # length at most max_length, which bounds the number of
+        # non-overlapping occurrences from above. Without the bound on the
+        # length, there are quadratically many keys in the length of the
+        # rules, of total size cubic in the length.
+        counts = {}
+        for word in _flatten(self.pairs):
+            for i in range(len(word)):
+                last = min(i + max_length, len(word))
+                for j in range(i + min_length, last + 1):
+                    if j - i == len(word):
+                        break
+                    key = tuple(word[i:j])
+                    counts[key] = counts.get(key, 0) + 1
+
+        # Replacing k occurrences of w by a new letter x shortens the rules by
+        # k * (|w| - 1), and adds the rule w = x of length |w| + 1.
+        def gain(w, k):
+            return k * (len(w) - 1) - (len(w) + 1)
+
+        candidates = sorted(
+            ((gain(w, k), w) for w, k in counts.items() if gain(w, k) > 0),
+            key=lambda x: (-x[0], -len(x[1]), x[1]),
+        )
+        best, best_gain = None, 0
+        for bound, w in candidates:
+            if bound <= best_gain:
+                break
+            k = sum(
+                _count_subword(word, list(w)) for word in _flatten(self.pairs)
+            )
+            if gain(w, k) > best_gain:
+                best, best_gain = list(w), gain(w, k)
+        return best
+
+    def replace_common_subwords(self, min_length, max_length):
+        while True:
+            w = self._best_subword(min_length, max_length)
+            if w is None:
+                return
+            x = max(self.alphabet, default=-1) + 1
+            self.pairs = [
+                (_replace_subword(u, w, x), _replace_subword(v, w, x))
+                for u, v in self.pairs
+            ]
+            self.pairs.append((w, [x]))
+            self.alphabet.append(x)
+            self.backward[x] = [b for a in w for b in self.backward[a]]
+
+    def normalize_alphabet(self):
+        relabel = {a: i for i, a in enumerate(self.alphabet)}
+        self.pairs = [
+            ([relabel[a] for a in u], [relabel[a] for a in v])
+            for u, v in self.pairs
+        ]
+        self.alphabet = list(range(len(self.alphabet)))
+        self.forward = {
+            b: [relabel[a] for a in image] for b, image in self.forward.items()
+        }
+        self.backward = {
+            relabel[a]: image for a, image in self.backward.items()
+        }
+
+    def presentation(self):
+        q = Presentation()
+        if len(self.alphabet) != 0:
+            q.alphabet(len(self.alphabet))
+        q.contains_empty_word(self.contains_empty_word)
+        _set_pairs(q, self.pairs)
+        return q
+
+
+def simplify(
+    p,
+    eliminate_generators=True,
+    replace_common_subwords=True,
+    min_subword_length=2,
+    max_subword_length=16,
+):
+    """
+    Simplify the presentation ``p`` using Tietze transformations. This is
+    intended to be used before running :py:class:`ToddCoxeter`,
+    :py:class:`KnuthBendix` or :py:class:`Sims1`, the performance of which
+    often depends heavily on the shape of the presentation.
+
+    The following transformations are applied, in this order:
+
+    #. trivial rules ``u = u`` and duplicate rules are removed;
+    #. if ``eliminate_generators`` is ``True``, then every generator ``a``
+       occurring in a rule ``a = w`` where ``a`` does not occur in ``w`` is
+       removed from the alphabet, and replaced by ``w`` in every other rule;
+    #. if ``replace_common_subwords`` is ``True``, then, while doing so
+       reduces the total length of the rules, a subword ``w`` of length at
+       least ``min_subword_length`` and at most ``max_subword_length``
+       occurring several times in the rules is replaced by a new generator
+       ``x``, and the rule ``w = x`` is added;
+    #. the alphabet is relabelled to be ``[0, 1, ..., n - 1]``.
+
+    The argument ``p`` is not modified.
+
+    :param p: the presentation.
+    :type p: Presentation
+    :param eliminate_generators: whether or not to eliminate generators.
+    :type eliminate_generators: bool
+    :param replace_common_subwords: whether or not to introduce new generators.
+    :type replace_common_subwords: bool
+    :param min_subword_length: the minimum length of a replaced subword.
+    :type min_subword_length: int
+    :param max_subword_length: the maximum length of a replaced subword.
+    :type max_subword_length: int
+
+    :return: A :py:class:`PresentationSimplification`.
+
+    :raises RuntimeError: if ``p`` is not valid.
+    :raises ValueError: if ``min_subword_length`` is less than ``2``.
+    :raises ValueError:
+      if ``max_subword_length`` is less than ``min_subword_length``.
+    """
+    if min_subword_length < 2:
+        raise ValueError(
+            "the minimum subword length must be at least 2, found "
+            f"{min_subword_length}"
+        )
+    if max_subword_length < min_subword_length:
+        raise ValueError(
+            "the maximum subword length must be at least the minimum "
+            f"subword length {min_subword_length}, found {max_subword_length}"
+        )
+    s = _Simplifier(p)
+    if eliminate_generators:
+        s.eliminate_generators()
+    if replace_common_subwords:
+        s.replace_common_subwords(min_subword_length, max_subword_length)
+    s.normalize_alphabet()
+    return PresentationSimplification(s.presentation(), s.forward, s.backward)
@@ -13,7 +13,7 @@
 This package provides a the user-facing python part of libsemigroups_pybind11
 relating to transformations.
 """
-from typing import List
+from typing import List, Union
 from _libsemigroups_pybind11 import (
     Transf16,
     Transf1,
@@ -27,19 +27,35 @@ from _libsemigroups_pybind11 import (
     Perm1,
     Perm2,
     Perm4,
+    transf_from_buffer,
+    pperm_from_buffer,
+    perm_from_buffer,
 )
 
 
-def Transf(images: List[int]):
+def _is_buffer(images) -> bool:
+    try:
+        memoryview(images)
+    except TypeError:
+        return False
+    return True
+
+
+def Transf(images: Union[List[int], bytes, memoryview]):
     """
     Construct the minimum space occupying _libsemigroups_pybind11
-    transformation from a list of images.
+    transformation from a list of images, or from a one-dimensional buffer
+    of integers, such as ``bytes`` or a ``numpy.ndarray``, which is read
+    without converting its entries to python ints.
     """
     if not isinstance(images, list):
-        raise TypeError("the argument must be a list")
+        if _is_buffer(images):
+            return transf_from_buffer(images)
+        raise TypeError(
+            "the argument must be a list or support the buffer protocol"
+        )
     if len(images) <= 16:
-        images += range(len(images), 16)
-        return Transf16.make(images)
+        return Transf16.make(images + list(range(len(images), 16)))
     if len(images) <= 2 ** 8:
         return Transf1.make(images)
     if len(images) <= 2 ** 16:
@@ -52,16 +68,20 @@ def Transf(images: List[int]):
     )
 
 
-def PPerm(images: List[int]):
+def PPerm(images: Union[List[int], bytes, memoryview]):
     """
     Construct the minimum space occupying _libsemigroups_pybind11
-    partial perm from a list of images.
+    partial perm from a list of images, or from a one-dimensional buffer
+    of integers, see :py:func:`Transf`.
     """
     if not isinstance(images, list):
-        raise TypeError("the argument must be a list")
+        if _is_buffer(images):
+            return pperm_from_buffer(images)
+        raise TypeError(
+            "the argument must be a list or support the buffer protocol"
+        )
     if len(images) <= 16:
-        images += range(len(images), 16)
-        return PPerm16.make(images)
+        return PPerm16.make(images + list(range(len(images), 16)))
     if len(images) <= 2 ** 8:
         return PPerm1.make(images)
     if len(images) <= 2 ** 16:
@@ -74,16 +94,20 @@ def PPerm(images: List[int]):
     )
 
 
-def Perm(images: List[int]):
+def Perm(images: Union[List[int], bytes, memoryview]):
     """
     Construct the minimum space occupying _libsemigroups_pybind11
-    perm from a list of images.
+    perm from a list of images, or from a one-dimensional buffer of
+    integers, see :py:func:`Transf`.
     """
     if not isinstance(images, list):
-        raise TypeError("the argument must be a list")
+        if _is_buffer(images):
+            return perm_from_buffer(images)
+        raise TypeError(
+            "the argument must be a list or support the buffer protocol"
+        )
     if len(images) <= 16:
-        images += range(len(images), 16)
-        return Perm16.make(images)
+        return Perm16.make(images + list(range(len(images), 16)))
     if len(images) <= 2 ** 8:
         return Perm1.make(images)
     if len(images) <= 2 ** 16:
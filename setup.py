@@ -29,7 +29,7 @@ def minimum_libsemigroups_version():
     Returns the minimum required version of libsemigroups required to make
     this work.
     """
-    return "2.0.2"
+    return "2.3.0"
 
 
 def compare_version_numbers(supplied, required):
@@ -212,7 +212,7 @@ setup(
     ext_modules=ext_modules,
     packages=find_packages(),
     setup_requires=["pkgconfig>=0.29.2"],
-    install_requires=["pybind11>=2.6", "packaging>=20.4"],
+    install_requires=["pybind11>=2.6", "packaging>=20.4", "numpy>=1.17"],
     tests_require=["pytest==6.2.4"],
     cmdclass={"build_ext": build_ext},
     zip_safe=False,
@@ -0,0 +1,457 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <cstdint>
+#include <type_traits>
+
+#include <pybind11/chrono.h>
+#include <pybind11/functional.h>
+#include <pybind11/operators.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <libsemigroups/libsemigroups.hpp>
+
+#include "doc-strings.hpp"
+#include "main.hpp"
+
+namespace py = pybind11;
+
+namespace libsemigroups {
+  namespace {
+
+    // libsemigroups doesn't provide an ImageRightAction for every combination
+    // of (partial) transformation and integer point, so we use this one for
+    // the orbits of points.
+    template <typename Element, typename Point>
+    struct ImageOfPoint {
+      void operator()(Point &res, Point const &pt, Element const &x) const {
+        res = x[pt];
+      }
+    };
+
+    template <typename Element, typename Point>
+    using RightActionOnPoints
+        = RightAction<Element, Point, ImageOfPoint<Element, Point>>;
+
+    template <typename Element, typename Point>
+    using RightActionOnImages
+        = RightAction<Element, Point, ImageRightAction<Element, Point>>;
+
+    template <typename Element, typename Point>
+    using LeftActionOnImages
+        = LeftAction<Element, Point, ImageLeftAction<Element, Point>>;
+
+    template <typename T>
+    struct IsActionOnPoints : std::false_type {};
+
+    template <typename Element, typename Point>
+    struct IsActionOnPoints<RightActionOnPoints<Element, Point>>
+        : std::true_type {};
+
+    // Neither ImageOfPoint nor ImageRightAction/ImageLeftAction check their
+    // arguments, and so every seed and generator is checked against the
+    // degree of the first generator, which is stored as an attribute of the
+    // Python object, before it is added.
+    template <typename Point>
+    void validate_point(Point const &pt, size_t n, std::true_type) {
+      if (static_cast<size_t>(pt) >= n) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "expected a point less than the degree %llu of the generators, "
+            "found %llu",
+            static_cast<uint64_t>(n),
+            static_cast<uint64_t>(pt));
+      }
+    }
+
+    template <typename Point>
+    void validate_point(Point const &pt, size_t n, std::false_type) {
+      size_t const m = Degree<Point>()(pt);
+      if (m != n) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "expected a point of degree %llu (the degree of the generators), "
+            "found %llu",
+            static_cast<uint64_t>(n),
+            static_cast<uint64_t>(m));
+      }
+    }
+
+    template <typename Class>
+    void validate_point(py::object self,
+                        typename Class::point_type const &pt) {
+      if (py::hasattr(self, "_degree")) {
+        validate_point(pt,
+                       self.attr("_degree").cast<size_t>(),
+                       IsActionOnPoints<Class>());
+      }
+    }
+
+    template <typename Class>
+    void validate_generator(py::object                         self,
+                            typename Class::element_type const &x) {
+      using element_type = typename Class::element_type;
+      size_t const n     = Degree<element_type>()(x);
+      if (py::hasattr(self, "_degree")) {
+        size_t const m = self.attr("_degree").cast<size_t>();
+        if (n != m) {
+          LIBSEMIGROUPS_EXCEPTION(
+              "expected a generator of degree %llu (the degree of the "
+              "existing generators), found %llu",
+              static_cast<uint64_t>(m),
+              static_cast<uint64_t>(n));
+        }
+        return;
+      }
+      // The seeds may have been added before the first generator.
+      auto const &a = self.cast<Class const &>();
+      for (auto it = a.cbegin(); it != a.cend(); ++it) {
+        validate_point(*it, n, IsActionOnPoints<Class>());
+      }
+    }
+
+    template <typename T>
+    void bind_action(py::module &m, char const *typestr) {
+      using Class        = T;
+      using point_type   = typename Class::point_type;
+      using element_type = typename Class::element_type;
+      using index_type   = typename Class::index_type;
+
+      py::class_<Class> x(m, typestr, py::dynamic_attr());
+
+      x.def(py::init<>(),
+            R"pbdoc(
+              Default constructor.
+
+              Constructs an action with no generators and no seeds.
+            )pbdoc")
+          .def("reserve",
+               &Class::reserve,
+               py::arg("val"),
+               py::return_value_policy::reference,
+               R"pbdoc(
+                 Increase the capacity to a value that is greater or equal to
+                 ``val``.
+
+                 :param val: new capacity.
+                 :type val: int
+
+                 :return: ``self``.
+               )pbdoc")
+          .def(
+              "add_seed",
+              [](py::object self, point_type const &seed) {
+                validate_point<Class>(self, seed);
+                self.cast<Class &>().add_seed(seed);
+                return self;
+              },
+              py::arg("seed"),
+              R"pbdoc(
+                Add a seed to the action.
+
+                A *seed* is just a starting point for the action, it will
+                belong to the action, as will every point that can be
+                obtained from the seed by acting with the generators.
+
+                :param seed: the seed to add.
+                :type seed: Point
+
+                :return: ``self``.
+
+                :raises RuntimeError:
+                  if ``seed`` cannot be acted on by the generators, i.e. it
+                  is a point not less than their degree, or it is of a
+                  different degree.
+              )pbdoc")
+          .def(
+              "add_generator",
+              [](py::object self, element_type const &x) {
+                validate_generator<Class>(self, x);
+                self.cast<Class &>().add_generator(x);
+                if (!py::hasattr(self, "_degree")) {
+                  self.attr("_degree") = Degree<element_type>()(x);
+                }
+                return self;
+              },
+              py::arg("x"),
+              R"pbdoc(
+                Add a generator to the action.
+
+                :param x: the generator to add.
+                :type x: Element
+
+                :return: ``self``.
+
+                :raises RuntimeError:
+                  if the degree of ``x`` differs from that of the existing
+                  generators, or some seed cannot be acted on by ``x``.
+              )pbdoc")
+          .def("number_of_generators",
+               &Class::number_of_generators,
+               R"pbdoc(
+                 Returns the number of generators.
+
+                 :Parameters: None
+                 :return: An ``int``.
+               )pbdoc")
+          .def("position",
+               &Class::position,
+               py::arg("pt"),
+               R"pbdoc(
+                 Returns the position of a point in the so far discovered
+                 points.
+
+                 :param pt: the point whose position is sought.
+                 :type pt: Point
+
+                 :return: An ``int`` or :py:obj:`UNDEFINED`.
+               )pbdoc")
+          .def("empty",
+               &Class::empty,
+               R"pbdoc(
+                 Checks if the action contains any points.
+
+                 :Parameters: None
+                 :return: A ``bool``.
+               )pbdoc")
+          .def(
+              "__getitem__",
+              [](Class const &a, size_t pos) { return a.at(pos); },
+              py::arg("pos"),
+              py::is_operator(),
+              R"pbdoc(
+                Returns the point in a given position.
+
+                :param pos: the index of the point.
+                :type pos: int
+
+                :return: A point.
+
+                :raises RuntimeError:
+                  if ``pos`` is not less than :py:meth:`current_size`.
+              )pbdoc")
+          .def("size",
+               &Class::size,
+               R"pbdoc(
+                 Returns the size of the fully enumerated action.
+
+                 :Parameters: None
+                 :return: An ``int``.
+               )pbdoc")
+          .def(
+              "current_size",
+              [](Class const &a) { return a.current_size(); },
+              R"pbdoc(
+                Returns the number of points found so far.
+
+                :Parameters: None
+                :return: An ``int``.
+              )pbdoc")
+          .def(
+              "__iter__",
+              [](Class const &a) {
+                return py::make_iterator(a.cbegin(), a.cend());
+              },
+              R"pbdoc(
+                Returns an iterator pointing to the first point in the action.
+
+                :Parameters: None
+                :return: An iterator.
+              )pbdoc")
+          .def("cache_scc_multipliers",
+               py::overload_cast<>(&Class::cache_scc_multipliers, py::const_),
+               R"pbdoc(
+                 Checks whether or not the multipliers to and from the roots
+                 of the strongly connected components are cached.
+
+                 :Parameters: None
+                 :return: A ``bool``.
+               )pbdoc")
+          .def("cache_scc_multipliers",
+               py::overload_cast<bool>(&Class::cache_scc_multipliers),
+               py::arg("val"),
+               py::return_value_policy::reference,
+               R"pbdoc(
+                 Set whether or not the multipliers to and from the roots of
+                 the strongly connected components should be cached.
+
+                 :param val: the value.
+                 :type val: bool
+
+                 :return: ``self``.
+               )pbdoc")
+          .def(
+              "multiplier_from_scc_root",
+              [](Class &a, index_type pos) {
+                return a.multiplier_from_scc_root(pos);
+              },
+              py::arg("pos"),
+              R"pbdoc(
+                Returns an element ``x`` of the semigroup generated by the
+                generators such that acting on the root of the strongly
+                connected component of the point in position ``pos`` by ``x``
+                gives the point in position ``pos``.
+
+                :param pos: the index of the point.
+                :type pos: int
+
+                :return: An element.
+
+                :raises RuntimeError: if ``pos`` is out of bounds.
+              )pbdoc")
+          .def(
+              "multiplier_to_scc_root",
+              [](Class &a, index_type pos) {
+                return a.multiplier_to_scc_root(pos);
+              },
+              py::arg("pos"),
+              R"pbdoc(
+                Returns an element ``x`` of the semigroup generated by the
+                generators such that acting on the point in position ``pos``
+                by ``x`` gives the root of its strongly connected component.
+
+                :param pos: the index of the point.
+                :type pos: int
+
+                :return: An element.
+
+                :raises RuntimeError: if ``pos`` is out of bounds.
+              )pbdoc")
+          .def(
+              "root_of_scc",
+              [](Class &a, point_type const &pt) -> point_type {
+                return a.root_of_scc(pt);
+              },
+              py::arg("pt"),
+              R"pbdoc(
+                Returns the root of the strongly connected component containing
+                a point. This triggers a full enumeration.
+
+                :param pt: the point.
+                :type pt: Point
+
+                :return: A point.
+
+                :raises RuntimeError: if ``pt`` does not belong to the action.
+              )pbdoc")
+          .def(
+              "digraph",
+              [](Class &a) -> ActionDigraph<size_t> const & {
+                return a.digraph();
+              },
+              py::return_value_policy::reference_internal,
+              R"pbdoc(
+                Returns the digraph of the action, as enumerated so far.
+
+                The nodes of the digraph are the positions of the points, and
+                there is an edge labelled ``i`` from ``m`` to ``n`` if acting
+                on the point in position ``m`` by the generator with index
+                ``i`` gives the point in position ``n``. The strongly connected
+                components can be obtained using, for example,
+                :py:meth:`ActionDigraph.scc_id` and
+                :py:meth:`ActionDigraph.number_of_scc`.
+
+                :Parameters: None
+                :return: An :py:class:`ActionDigraph`.
+              )pbdoc")
+          .def("run", &Class::run, runner_doc_strings::run)
+          .def("run_for",
+               (void(Class::  // NOLINT(whitespace/parens)
+                         *)(std::chrono::nanoseconds))
+                   & Runner::run_for,
+               py::arg("t"),
+               runner_doc_strings::run_for)
+          .def("run_until",
+               (void(Class::  // NOLINT(whitespace/parens)
+                         *)(std::function<bool()> &))
+                   & Runner::run_until,
+               py::arg("func"),
+               runner_doc_strings::run_until)
+          .def("kill", &Class::kill, runner_doc_strings::kill)
+          .def("dead", &Class::dead, runner_doc_strings::dead)
+          .def("finished", &Class::finished, runner_doc_strings::finished)
+          .def("started", &Class::started, runner_doc_strings::started)
+          .def("report", &Class::report, runner_doc_strings::report)
+          .def("report_every",
+               (void(Class::  // NOLINT(whitespace/parens)
+                         *)(std::chrono::nanoseconds))
+                   & Runner::report_every,
+               py::arg("t"),
+               runner_doc_strings::report_every)
+          .def("report_why_we_stopped",
+               &Class::report_why_we_stopped,
+               runner_doc_strings::report_why_we_stopped)
+          .def(
+              "running",
+              [](Class const &a) { return a.running(); },
+              runner_doc_strings::running)
+          .def("timed_out", &Class::timed_out, runner_doc_strings::timed_out)
+          .def("stopped", &Class::stopped, runner_doc_strings::stopped)
+          .def("stopped_by_predicate",
+               &Class::stopped_by_predicate,
+               runner_doc_strings::stopped_by_predicate)
+          .def("__repr__", [typestr](Class const &a) {
+            return std::string("<") + typestr + " with "
+                   + detail::to_string(a.number_of_generators())
+                   + " generators, " + detail::to_string(a.current_size())
+                   + " points>";
+          });
+    }
+  }  // namespace
+
+  void init_action(py::module &m) {
+    // Orbits of points
+    bind_action<RightActionOnPoints<LeastTransf<16>, uint8_t>>(
+        m, "RightActionTransf16UInt8");
+    bind_action<RightActionOnPoints<Transf<0, uint8_t>, uint8_t>>(
+        m, "RightActionTransf1UInt8");
+    bind_action<RightActionOnPoints<Transf<0, uint16_t>, uint16_t>>(
+        m, "RightActionTransf2UInt16");
+    bind_action<RightActionOnPoints<Transf<0, uint32_t>, uint32_t>>(
+        m, "RightActionTransf4UInt32");
+    bind_action<RightActionOnPoints<LeastPerm<16>, uint8_t>>(
+        m, "RightActionPerm16UInt8");
+    bind_action<RightActionOnPoints<Perm<0, uint8_t>, uint8_t>>(
+        m, "RightActionPerm1UInt8");
+    bind_action<RightActionOnPoints<Perm<0, uint16_t>, uint16_t>>(
+        m, "RightActionPerm2UInt16");
+    bind_action<RightActionOnPoints<Perm<0, uint32_t>, uint32_t>>(
+        m, "RightActionPerm4UInt32");
+
+    // Orbits of sets (represented as partial identities)
+    bind_action<RightActionOnImages<LeastPPerm<16>, LeastPPerm<16>>>(
+        m, "RightActionPPerm16PPerm16");
+    bind_action<RightActionOnImages<PPerm<0, uint8_t>, PPerm<0, uint8_t>>>(
+        m, "RightActionPPerm1PPerm1");
+    bind_action<RightActionOnImages<PPerm<0, uint16_t>, PPerm<0, uint16_t>>>(
+        m, "RightActionPPerm2PPerm2");
+    bind_action<RightActionOnImages<PPerm<0, uint32_t>, PPerm<0, uint32_t>>>(
+        m, "RightActionPPerm4PPerm4");
+    bind_action<LeftActionOnImages<LeastPPerm<16>, LeastPPerm<16>>>(
+        m, "LeftActionPPerm16PPerm16");
+    bind_action<LeftActionOnImages<PPerm<0, uint8_t>, PPerm<0, uint8_t>>>(
+        m, "LeftActionPPerm1PPerm1");
+    bind_action<LeftActionOnImages<PPerm<0, uint16_t>, PPerm<0, uint16_t>>>(
+        m, "LeftActionPPerm2PPerm2");
+    bind_action<LeftActionOnImages<PPerm<0, uint32_t>, PPerm<0, uint32_t>>>(
+        m, "LeftActionPPerm4PPerm4");
+
+    // Orbits of row and column spaces
+    bind_action<RightActionOnImages<BMat8, BMat8>>(m, "RightActionBMat8BMat8");
+    bind_action<LeftActionOnImages<BMat8, BMat8>>(m, "LeftActionBMat8BMat8");
+  }
+}  // namespace libsemigroups
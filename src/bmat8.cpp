@@ -18,8 +18,14 @@
 
 // Status: complete
 
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+
 #include <pybind11/chrono.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -27,13 +33,294 @@
 #include <libsemigroups/libsemigroups.hpp>
 
 #include "main.hpp"
+#include "parallel.hpp"
 
 namespace py = pybind11;
 
 namespace libsemigroups {
+  namespace {
+    using uint64_array
+        = py::array_t<uint64_t, py::array::c_style | py::array::forcecast>;
+
+    // The functions in this namespace compute the canonical form of a BMat8
+    // x, i.e. the least BMat8, with respect to <, obtained by permuting the
+    // rows and columns of x. Row i of a BMat8 is byte 7 - i of its integer
+    // representation, and column j is bit 7 - j of every such byte, and so
+    // the least matrix is the one whose first row is least, then whose second
+    // row is least, and so on.
+    //
+    // The rows of the canonical form are chosen one at a time. The column
+    // orderings making the rows already chosen least are those compatible
+    // with an ordered partition of the columns into <cells>. The least value
+    // of a further row is obtained by putting its 0s before its 1s in every
+    // cell, and choosing that row splits every cell into its 0s and its 1s.
+    // The rows with the least value are tried in turn, and the branches whose
+    // rows so far exceed those of the least matrix found so far are pruned.
+    // Swapping two columns in the same cell which maps the remaining rows to
+    // themselves also maps the branch for a row to the branch for its image,
+    // and so only one row in every orbit of such swaps is tried.
+    namespace canonical {
+      struct Partition {
+        std::array<uint8_t, 8> cells;
+        size_t                 size;
+      };
+
+      inline size_t popcount(uint8_t x) {
+        return std::bitset<8>(x).count();
+      }
+
+      inline uint8_t row(uint64_t x, size_t i) {
+        return static_cast<uint8_t>(x >> (56 - 8 * i));
+      }
+
+      inline uint8_t least_value(uint8_t r, Partition const &p) {
+        unsigned result = 0;
+        size_t   pos    = 0;
+        for (size_t c = 0; c < p.size; ++c) {
+          pos += popcount(p.cells[c]);
+          result |= ((1u << popcount(p.cells[c] & r)) - 1) << (8 - pos);
+        }
+        return static_cast<uint8_t>(result);
+      }
+
+      // Sorts the first <n> entries of <a>.
+      inline void sort(std::array<uint8_t, 8> &a, size_t n) {
+        for (size_t i = 1; i < n; ++i) {
+          uint8_t const v = a[i];
+          size_t        j = i;
+          for (; j > 0 && a[j - 1] > v; --j) {
+            a[j] = a[j - 1];
+          }
+          a[j] = v;
+        }
+      }
+
+      // Swaps the two bits of <r> in <swap>.
+      inline uint8_t apply(uint8_t r, uint8_t swap) {
+        return popcount(r & swap) == 1 ? r ^ swap : r;
+      }
+
+      // Returns the number of swaps of two columns in the same cell of <p>
+      // mapping the rows of <x> in <remaining> to themselves, and puts them
+      // into <swaps>.
+      inline size_t symmetries(uint64_t                 x,
+                               uint8_t                  remaining,
+                               Partition const &        p,
+                               std::array<uint8_t, 28> &swaps) {
+        std::array<uint8_t, 8> rows;
+        size_t                 n = 0;
+        for (size_t i = 0; i < 8; ++i) {
+          if (remaining & (1 << i)) {
+            rows[n++] = row(x, i);
+          }
+        }
+        sort(rows, n);
+        // A swap can only map the rows to themselves if both of its columns
+        // contain the same number of 1s.
+        std::array<size_t, 8> ones = {};
+        for (size_t i = 0; i < n; ++i) {
+          for (size_t a = 0; a < 8; ++a) {
+            ones[a] += (rows[i] >> a) & 1;
+          }
+        }
+        size_t result = 0;
+        for (size_t c = 0; c < p.size; ++c) {
+          for (size_t a = 0; a < 8; ++a) {
+            for (size_t b = a + 1; b < 8; ++b) {
+              uint8_t const swap = (1 << a) | (1 << b);
+              if ((p.cells[c] & swap) != swap || ones[a] != ones[b]) {
+                continue;
+              }
+              std::array<uint8_t, 8> images;
+              for (size_t i = 0; i < n; ++i) {
+                images[i] = apply(rows[i], swap);
+              }
+              sort(images, n);
+              if (std::equal(
+                      rows.cbegin(), rows.cbegin() + n, images.cbegin())) {
+                swaps[result++] = swap;
+              }
+            }
+          }
+        }
+        return result;
+      }
+
+      // Adds the orbit of <r> under <swaps> to <tried>.
+      inline void add_orbit(std::bitset<256> &             tried,
+                            uint8_t                        r,
+                            std::array<uint8_t, 28> const &swaps,
+                            size_t                         nr_swaps) {
+        std::array<uint8_t, 256> stack;
+        size_t                   top = 0;
+        tried.set(r);
+        stack[top++] = r;
+        while (top != 0) {
+          uint8_t const s = stack[--top];
+          for (size_t k = 0; k < nr_swaps; ++k) {
+            uint8_t const t = apply(s, swaps[k]);
+            if (!tried[t]) {
+              tried.set(t);
+              stack[top++] = t;
+            }
+          }
+        }
+      }
+
+      inline Partition refine(Partition const &p, uint8_t r) {
+        Partition result;
+        result.size = 0;
+        for (size_t c = 0; c < p.size; ++c) {
+          uint8_t const zeros = p.cells[c] & ~r;
+          uint8_t const ones  = p.cells[c] & r;
+          if (zeros != 0) {
+            result.cells[result.size++] = zeros;
+          }
+          if (ones != 0) {
+            result.cells[result.size++] = ones;
+          }
+        }
+        return result;
+      }
+
+      // <remaining> is the set of rows of <x> not yet chosen, and <prefix>
+      // contains the <depth> rows already chosen.
+      void search(uint64_t const   x,
+                  uint8_t const    remaining,
+                  Partition const &p,
+                  size_t const     depth,
+                  uint64_t const   prefix,
+                  uint64_t &       best) {
+        if (depth == 8) {
+          best = std::min(best, prefix);
+          return;
+        }
+        std::array<uint8_t, 8> values;
+        uint8_t                least = 0xFF;
+        for (size_t i = 0; i < 8; ++i) {
+          if (remaining & (1 << i)) {
+            values[i] = least_value(row(x, i), p);
+            least     = std::min(least, values[i]);
+          }
+        }
+        if (p.size == 8) {
+          // The column ordering is determined, so the remaining rows are
+          // sorted.
+          std::array<uint8_t, 8> rows;
+          size_t                 n = 0;
+          for (size_t i = 0; i < 8; ++i) {
+            if (remaining & (1 << i)) {
+              rows[n++] = values[i];
+            }
+          }
+          sort(rows, n);
+          uint64_t result = prefix;
+          for (size_t i = 0; i < n; ++i) {
+            result |= static_cast<uint64_t>(rows[i]) << (56 - 8 * (depth + i));
+          }
+          best = std::min(best, result);
+          return;
+        }
+        uint64_t const next
+            = prefix | (static_cast<uint64_t>(least) << (56 - 8 * depth));
+        uint64_t const mask = ~uint64_t(0) << (56 - 8 * depth);
+        if ((next & mask) > (best & mask)) {
+          return;
+        }
+        std::bitset<256>        tried;
+        std::array<uint8_t, 8>  branches;
+        size_t                  nr_branches = 0;
+        std::array<uint8_t, 28> swaps;
+        size_t                  nr_swaps = 0;
+        bool                    known    = false;
+        for (size_t i = 0; i < 8; ++i) {
+          uint8_t const r = row(x, i);
+          if (!(remaining & (1 << i)) || values[i] != least || tried[r]) {
+            continue;
+          }
+          if (nr_branches != 0 && !known) {
+            // The symmetries are only computed if there is more than one
+            // branch.
+            nr_swaps = symmetries(x, remaining, p, swaps);
+            known    = true;
+            for (size_t k = 0; k < nr_branches; ++k) {
+              add_orbit(tried, branches[k], swaps, nr_swaps);
+            }
+            if (tried[r]) {
+              continue;
+            }
+          }
+          search(x, remaining & ~(1 << i), refine(p, r), depth + 1, next, best);
+          branches[nr_branches++] = r;
+          add_orbit(tried, r, swaps, nr_swaps);
+        }
+      }
+
+      inline uint64_t canonical_form(uint64_t x) {
+        Partition p;
+        p.cells[0]    = 0xFF;
+        p.size        = 1;
+        uint64_t best = x;
+        search(x, 0xFF, p, 0, 0, best);
+        return best;
+      }
+
+      // If <transpose> is true, then the canonical form of <x> under
+      // transposition as well as row and column permutations is returned.
+      inline uint64_t canonical_form(uint64_t x, bool transpose) {
+        uint64_t const result = canonical_form(x);
+        if (!transpose) {
+          return result;
+        }
+        return std::min(result,
+                        canonical_form(BMat8(x).transpose().to_int()));
+      }
+    }  // namespace canonical
+
+    // Returns the array of the same shape as <a> whose entries are f(x) for
+    // every BMat8 x in <a>, computed without the GIL using at most
+    // <number_of_threads> threads.
+    template <typename Result, typename Func>
+    py::array_t<Result> bmat8_map(uint64_array const &a,
+                                  size_t              number_of_threads,
+                                  Func &&             f) {
+      py::array_t<Result> result(
+          std::vector<py::ssize_t>(a.shape(), a.shape() + a.ndim()));
+      uint64_t const *in  = a.data();
+      Result *        out = result.mutable_data();
+      {
+        py::gil_scoped_release release;
+        detail::parallel_for(a.size(),
+                             number_of_threads,
+                             [in, out, &f](size_t first, size_t last) {
+                               for (size_t i = first; i < last; ++i) {
+                                 out[i] = f(BMat8(in[i]));
+                               }
+                             });
+      }
+      return result;
+    }
+
+    template <typename Result, typename Func>
+    void def_bmat8_map(py::class_<BMat8> &x,
+                       char const *       name,
+                       Func               f,
+                       char const *       doc) {
+      x.def_static(
+          name,
+          [f](uint64_array const &a, size_t number_of_threads) {
+            return bmat8_map<Result>(a, number_of_threads, f);
+          },
+          py::arg("a"),
+          py::arg("number_of_threads") = 1,
+          doc);
+    }
+  }  // namespace
+
   void init_bmat8(py::module &m) {
-    py::class_<BMat8>(m, "BMat8")
-        .def(py::init<>(), R"pbdoc(
+    py::class_<BMat8> x(m, "BMat8");
+
+    x.def(py::init<>(), R"pbdoc(
       Returns an uninitalised BMat8.
       )pbdoc")
         .def(py::init<uint64_t>())
@@ -80,6 +367,7 @@ namespace libsemigroups {
               #           00000000
               )pbdoc")
 
+        .def("__hash__", [](BMat8 const &x) { return Hash<BMat8>()(x); })
         .def("to_int",
              &BMat8::to_int,
              R"pbdoc(
@@ -290,6 +578,154 @@ namespace libsemigroups {
                from libsemigroups_pybind11 import BMat8
                x = BMat8([[0, 1], [1, 0]])
                x.minimum_dim() # returns 2
-              )pbdoc");
+              )pbdoc")
+        .def(
+            "canonical_form",
+            [](BMat8 const &y, bool transpose) {
+              return BMat8(canonical::canonical_form(y.to_int(), transpose));
+            },
+            py::arg("transpose") = false,
+            R"pbdoc(
+              Returns the least ``BMat8``, with respect to ``<``, which can be
+              obtained from ``self`` by permuting its rows and columns. Two
+              ``BMat8`` objects have the same canonical form if and only if
+              one can be obtained from the other by permuting its rows and
+              columns. If ``transpose`` is ``True``, then transposing is also
+              allowed.
+
+              Any of the 8 rows and 8 columns can be permuted, and so rows and
+              columns containing only ``0`` come first in the canonical form.
+
+              :param transpose:
+                whether or not to allow transposing (default: ``False``).
+              :type transpose: bool
+
+              :return: A ``BMat8``.
+
+              .. code-block:: python
+
+                 from libsemigroups_pybind11 import BMat8
+                 x = BMat8([[1, 0], [1, 1]])
+                 y = BMat8([[1, 1], [0, 1]])
+                 x.canonical_form() == y.canonical_form() # returns True
+            )pbdoc");
+
+    ////////////////////////////////////////////////////////////////////////
+    // Functions for arrays of BMat8s
+    ////////////////////////////////////////////////////////////////////////
+
+    def_bmat8_map<uint64_t>(
+        x,
+        "row_space_sizes",
+        [](BMat8 const &y) { return y.row_space_size(); },
+        R"pbdoc(
+          Returns the array of the sizes of the row spaces of the matrices
+          in ``a``, where every matrix is given by its integer
+          representation, as returned by :py:meth:`to_int`.
+
+          :param a: the matrices.
+          :type a: numpy.ndarray
+          :param number_of_threads: the number of threads (default: ``1``).
+          :type number_of_threads: int
+
+          :return: A ``numpy.ndarray`` of the same shape as ``a``.
+
+          .. code-block:: python
+
+             import numpy
+             from libsemigroups_pybind11 import BMat8
+             a = numpy.array([BMat8([[0, 1], [1, 0]]).to_int()], dtype="uint64")
+             BMat8.row_space_sizes(a) # returns array([4], dtype=uint64)
+        )pbdoc");
+    def_bmat8_map<uint64_t>(
+        x,
+        "row_space_bases",
+        [](BMat8 const &y) { return y.row_space_basis().to_int(); },
+        R"pbdoc(
+          Returns the array of the integer representations of
+          :py:meth:`row_space_basis` of the matrices in ``a``, see
+          :py:meth:`row_space_sizes`.
+
+          :param a: the matrices.
+          :type a: numpy.ndarray
+          :param number_of_threads: the number of threads (default: ``1``).
+          :type number_of_threads: int
+
+          :return: A ``numpy.ndarray`` of the same shape as ``a``.
+        )pbdoc");
+    def_bmat8_map<uint64_t>(
+        x,
+        "col_space_bases",
+        [](BMat8 const &y) { return y.col_space_basis().to_int(); },
+        R"pbdoc(
+          Returns the array of the integer representations of
+          :py:meth:`col_space_basis` of the matrices in ``a``, see
+          :py:meth:`row_space_sizes`.
+
+          :param a: the matrices.
+          :type a: numpy.ndarray
+          :param number_of_threads: the number of threads (default: ``1``).
+          :type number_of_threads: int
+
+          :return: A ``numpy.ndarray`` of the same shape as ``a``.
+        )pbdoc");
+    def_bmat8_map<uint64_t>(
+        x,
+        "minimum_dims",
+        [](BMat8 const &y) { return bmat8_helpers::minimum_dim(y); },
+        R"pbdoc(
+          Returns the array of :py:meth:`minimum_dim` of the matrices in
+          ``a``, see :py:meth:`row_space_sizes`.
+
+          :param a: the matrices.
+          :type a: numpy.ndarray
+          :param number_of_threads: the number of threads (default: ``1``).
+          :type number_of_threads: int
+
+          :return: A ``numpy.ndarray`` of the same shape as ``a``.
+        )pbdoc");
+    x.def_static(
+        "canonical_forms",
+        [](uint64_array const &a, bool transpose, size_t number_of_threads) {
+          return bmat8_map<uint64_t>(
+              a, number_of_threads, [transpose](BMat8 const &y) {
+                return canonical::canonical_form(y.to_int(), transpose);
+              });
+        },
+        py::arg("a"),
+        py::arg("transpose")         = false,
+        py::arg("number_of_threads") = 1,
+        R"pbdoc(
+          Returns the array of the integer representations of
+          :py:meth:`canonical_form` of the matrices in ``a``, see
+          :py:meth:`row_space_sizes`. The classes of the matrices in ``a``
+          under permuting rows and columns can be found by sorting the
+          returned array, for example, using ``numpy.unique``.
+
+          :param a: the matrices.
+          :type a: numpy.ndarray
+          :param transpose:
+            whether or not to allow transposing (default: ``False``).
+          :type transpose: bool
+          :param number_of_threads: the number of threads (default: ``1``).
+          :type number_of_threads: int
+
+          :return: A ``numpy.ndarray`` of the same shape as ``a``.
+        )pbdoc");
+    def_bmat8_map<bool>(
+        x,
+        "are_regular_elements",
+        [](BMat8 const &y) { return y.is_regular_element(); },
+        R"pbdoc(
+          Returns the array of :py:meth:`is_regular_element` of the matrices
+          in ``a``, see :py:meth:`row_space_sizes`.
+
+          :param a: the matrices.
+          :type a: numpy.ndarray
+          :param number_of_threads: the number of threads (default: ``1``).
+          :type number_of_threads: int
+
+          :return: A ``numpy.ndarray`` of ``bool`` of the same shape as ``a``.
+        )pbdoc");
   }
 }  // namespace libsemigroups
@@ -0,0 +1,495 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <pybind11/chrono.h>
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
+#include <pybind11/operators.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <libsemigroups/libsemigroups.hpp>
+
+#include "element-array.hpp"
+#include "main.hpp"
+
+namespace py = pybind11;
+
+namespace libsemigroups {
+  namespace {
+    template <typename T>
+    void validate_index(ElementArray<T> const &a, size_t i) {
+      if (i >= a.size()) {
+        throw py::index_error();
+      }
+    }
+
+    template <typename T>
+    void validate_arrays(ElementArray<T> const &x, ElementArray<T> const &y) {
+      if (x.degree() != y.degree() || x.size() != y.size()) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "expected arrays of equal degree and length, found degrees %llu "
+            "and %llu, and lengths %llu and %llu",
+            static_cast<uint64_t>(x.degree()),
+            static_cast<uint64_t>(y.degree()),
+            static_cast<uint64_t>(x.size()),
+            static_cast<uint64_t>(y.size()));
+      }
+    }
+
+    template <typename T>
+    ElementArray<T> products(ElementArray<T> const &x,
+                             ElementArray<T> const &y,
+                             size_t                 number_of_threads) {
+      validate_arrays(x, y);
+      ElementArray<T>        result(x.degree());
+      py::gil_scoped_release release;
+      result.product_inplace(x, y, number_of_threads);
+      return result;
+    }
+
+    template <typename T>
+    auto bind_element_array(py::module &m, std::string const &typestr) {
+      using Array              = ElementArray<T>;
+      std::string pyclass_name = typestr + "Array";
+      py::class_<Array> x(m,
+                          pyclass_name.c_str(),
+                          R"pbdoc(
+        A sequence of elements of the same degree, which are stored
+        contiguously in a single block of memory, rather than as individual
+        Python objects.
+      )pbdoc");
+
+      x.attr("element_type") = m.attr(typestr.c_str());
+
+      x.def(py::init<size_t>(),
+            py::arg("n"),
+            R"pbdoc(
+              Constructs an empty array of elements of degree ``n``.
+
+              :param n: the degree.
+              :type n: int
+            )pbdoc")
+          .def(py::init<Array const &>())
+          .def(py::init([](std::vector<T> const &xs) {
+                 if (xs.empty()) {
+                   LIBSEMIGROUPS_EXCEPTION("expected a non-empty list");
+                 }
+                 Array result(xs[0].degree());
+                 result.reserve(xs.size());
+                 for (auto const &y : xs) {
+                   result.push_back(y);
+                 }
+                 return result;
+               }),
+               py::arg("xs"),
+               R"pbdoc(
+                 Constructs an array containing the elements in the list
+                 ``xs``.
+
+                 :param xs: the elements.
+                 :type xs: list
+
+                 :raises RuntimeError:
+                   if ``xs`` is empty, or its elements do not have equal
+                   degrees.
+               )pbdoc")
+          .def(py::init([](FroidurePin<T> const &S) {
+                 if (S.number_of_generators() == 0) {
+                   LIBSEMIGROUPS_EXCEPTION("expected at least 1 generator");
+                 }
+                 Array result(S.generator(0).degree());
+                 result.reserve(S.number_of_generators());
+                 for (size_t i = 0; i < S.number_of_generators(); ++i) {
+                   result.push_back(S.generator(i));
+                 }
+                 return result;
+               }),
+               py::arg("S"),
+               R"pbdoc(
+                 Constructs an array containing the generators of the
+                 :py:class:`FroidurePin` instance ``S``.
+
+                 :param S: the semigroup.
+                 :type S: FroidurePin
+
+                 :raises RuntimeError: if ``S`` has no generators.
+               )pbdoc")
+          .def(py::self == py::self)
+          .def(py::self != py::self)
+          .def("degree",
+               &Array::degree,
+               R"pbdoc(
+                 Returns the degree of the elements.
+
+                 :Parameters: None
+                 :return: An ``int``.
+               )pbdoc")
+          .def("__len__", &Array::size)
+          .def(
+              "__getitem__",
+              [](Array const &a, size_t i) {
+                validate_index(a, i);
+                return a.at(i);
+              },
+              py::arg("i"))
+          .def(
+              "__setitem__",
+              [](Array &a, size_t i, T const &y) {
+                validate_index(a, i);
+                a.set(i, y);
+              },
+              py::arg("i"),
+              py::arg("x"))
+          .def("append",
+               &Array::push_back,
+               py::arg("x"),
+               R"pbdoc(
+                 Appends the element ``x``.
+
+                 :param x: the element.
+                 :type x: element_type
+
+                 :return: (None)
+
+                 :raises RuntimeError:
+                   if the degree of ``x`` is not :py:meth:`degree`.
+               )pbdoc")
+          .def(
+              "__mul__",
+              [](Array const &a, Array const &b) {
+                return products(a, b, 1);
+              },
+              py::is_operator())
+          .def_static("products",
+                      &products<T>,
+                      py::arg("xs"),
+                      py::arg("ys"),
+                      py::arg("number_of_threads") = 1,
+                      R"pbdoc(
+                        Returns the array of the products ``xs[i] * ys[i]``.
+                        The products are computed directly on the packed
+                        representations of the elements, without the GIL.
+
+                        :param xs: the left-hand factors.
+                        :type xs: ElementArray
+                        :param ys: the right-hand factors.
+                        :type ys: ElementArray
+                        :param number_of_threads:
+                          the number of threads (default: ``1``).
+                        :type number_of_threads: int
+
+                        :return: An array of the same type as ``xs``.
+
+                        :raises RuntimeError:
+                          if ``xs`` and ``ys`` do not have equal degrees and
+                          lengths.
+                      )pbdoc")
+          .def(
+              "equal",
+              [](Array const &a, Array const &b) {
+                validate_arrays(a, b);
+                py::array_t<bool> result(a.size());
+                bool *            out = result.mutable_data();
+                for (size_t i = 0; i < a.size(); ++i) {
+                  out[i] = a.equal(i, b, i);
+                }
+                return result;
+              },
+              py::arg("that"),
+              R"pbdoc(
+                Returns the array whose ``i``-th entry is ``True`` if
+                ``self[i] == that[i]``, and ``False`` if not.
+
+                :param that: the array to compare with.
+                :type that: ElementArray
+
+                :return: A ``numpy.ndarray`` of dtype ``bool``.
+
+                :raises RuntimeError:
+                  if ``self`` and ``that`` do not have equal degrees and
+                  lengths.
+              )pbdoc")
+          .def(
+              "hashes",
+              [](Array const &a) {
+                py::array_t<uint64_t> result(a.size());
+                uint64_t *            out = result.mutable_data();
+                for (size_t i = 0; i < a.size(); ++i) {
+                  out[i] = a.hash_value(i);
+                }
+                return result;
+              },
+              R"pbdoc(
+                Returns the array of the hash values of the elements. Equal
+                elements have equal hash values.
+
+                :Parameters: None
+                :return: A ``numpy.ndarray`` of dtype ``uint64``.
+              )pbdoc")
+          .def("sort",
+               &Array::sort,
+               py::call_guard<py::gil_scoped_release>(),
+               R"pbdoc(
+                 Sorts the elements in-place. For transformations, partial
+                 perms, perms and bipartitions, the elements are sorted with
+                 respect to ``<``, and for other elements with respect to an
+                 unspecified total order.
+
+                 :Parameters: None
+                 :return: (None)
+               )pbdoc")
+          .def(
+              "unique",
+              [](Array const &a) {
+                Array                  result(a);
+                py::gil_scoped_release release;
+                result.sort();
+                result.unique();
+                return result;
+              },
+              R"pbdoc(
+                Returns a sorted array containing every element of ``self``
+                exactly once, see :py:meth:`sort`.
+
+                :Parameters: None
+                :return: An array of the same type as ``self``.
+              )pbdoc")
+          .def(
+              "to_list",
+              [](Array const &a) {
+                std::vector<T> result;
+                result.reserve(a.size());
+                for (size_t i = 0; i < a.size(); ++i) {
+                  result.push_back(a.at(i));
+                }
+                return result;
+              },
+              R"pbdoc(
+                Returns the list of the elements.
+
+                :Parameters: None
+                :return: A ``list``.
+              )pbdoc")
+          .def(
+              "froidure_pin",
+              [](Array const &a) {
+                if (a.size() == 0) {
+                  LIBSEMIGROUPS_EXCEPTION("expected a non-empty array");
+                }
+                std::vector<T> gens;
+                gens.reserve(a.size());
+                for (size_t i = 0; i < a.size(); ++i) {
+                  gens.push_back(a.at(i));
+                }
+                return std::make_shared<FroidurePin<T>>(gens);
+              },
+              R"pbdoc(
+                Returns a :py:class:`FroidurePin` instance generated by the
+                elements.
+
+                :Parameters: None
+                :return: A :py:class:`FroidurePin`.
+
+                :raises RuntimeError: if ``self`` is empty.
+              )pbdoc")
+          .def("__repr__", [pyclass_name](Array const &a) {
+            return std::string("<") + pyclass_name + " of "
+                   + detail::to_string(a.size()) + " elements of degree "
+                   + detail::to_string(a.degree()) + ">";
+          });
+      return x;
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // Bipartitions
+    ////////////////////////////////////////////////////////////////////////
+
+    using lookup_array_type
+        = py::array_t<uint32_t, py::array::c_style | py::array::forcecast>;
+
+    // Throws if the blocks in some row of the rows x cols array <a> are not
+    // numbered in the order in which they first occur, as required by
+    // Bipartition::make.
+    void validate_lookups(uint32_t const *a, size_t rows, size_t cols) {
+      for (size_t i = 0; i < rows; ++i) {
+        uint32_t next = 0;
+        for (size_t j = 0; j < cols; ++j) {
+          uint32_t const b = a[i * cols + j];
+          if (b == next) {
+            ++next;
+          } else if (b > next) {
+            LIBSEMIGROUPS_EXCEPTION(
+                "expected a block index at most %llu, found %llu in row %llu "
+                "and column %llu",
+                static_cast<uint64_t>(next),
+                static_cast<uint64_t>(b),
+                static_cast<uint64_t>(i),
+                static_cast<uint64_t>(j));
+          }
+        }
+      }
+    }
+
+    // Sets out[b] to true if the block b of the bipartition of degree n with
+    // lookup x is transverse, and to false if not, for every b < 2n.
+    template <typename OutputIt>
+    void transverse_blocks(uint32_t const *   x,
+                           size_t             n,
+                           std::vector<bool> &left,
+                           OutputIt           out) {
+      left.assign(2 * n, false);
+      std::fill(out, out + 2 * n, false);
+      for (size_t i = 0; i < n; ++i) {
+        left[x[i]] = true;
+      }
+      for (size_t i = n; i < 2 * n; ++i) {
+        out[x[i]] = left[x[i]];
+      }
+    }
+
+    void bind_bipartition_array(py::class_<ElementArray<Bipartition>> &x) {
+      using Array = ElementArray<Bipartition>;
+      x.def_static(
+           "from_numpy",
+           [](py::array const &lookups) {
+             auto a = lookup_array_type::ensure(lookups);
+             if (!a) {
+               throw py::error_already_set();
+             } else if (a.ndim() != 2) {
+               LIBSEMIGROUPS_EXCEPTION(
+                   "expected a 2-dimensional array, found %llu dimension(s)",
+                   static_cast<uint64_t>(a.ndim()));
+             } else if (a.shape(1) % 2 != 0) {
+               LIBSEMIGROUPS_EXCEPTION(
+                   "expected an even number of columns, found %llu",
+                   static_cast<uint64_t>(a.shape(1)));
+             }
+             size_t const           rows = a.shape(0), cols = a.shape(1);
+             Array                  result(cols / 2);
+             py::gil_scoped_release release;
+             validate_lookups(a.data(), rows, cols);
+             result.resize(rows);
+             std::copy(a.data(), a.data() + rows * cols, result.data(0));
+             return result;
+           },
+           py::arg("lookups"),
+           R"pbdoc(
+             Returns the array of bipartitions whose lookups are the rows of
+             the 2-dimensional array ``lookups``, i.e. the entry in row ``i``
+             and column ``j`` is the index of the block containing the point
+             ``j`` in the ``i``-th bipartition, as in
+             :py:meth:`Bipartition.make`. The degree of the bipartitions is
+             half the number of columns.
+
+             :param lookups: the lookups.
+             :type lookups: numpy.ndarray
+
+             :return: A ``BipartitionArray``.
+
+             :raises RuntimeError:
+               if ``lookups`` is not 2-dimensional, or does not have an even
+               number of columns, or the blocks in some row are not numbered
+               in the order in which they first occur.
+           )pbdoc")
+          .def(
+              "to_numpy",
+              [](Array const &a) {
+                size_t const      cols = a.words_per_element();
+                lookup_array_type result({a.size(), cols});
+                std::copy(a.data(0),
+                          a.data(0) + a.size() * cols,
+                          result.mutable_data());
+                return result;
+              },
+              R"pbdoc(
+                Returns the 2-dimensional array whose ``i``-th row is the
+                lookup of the ``i``-th bipartition, see :py:meth:`from_numpy`.
+
+                :Parameters: None
+                :return: A ``numpy.ndarray`` of dtype ``uint32``.
+              )pbdoc")
+          .def(
+              "ranks",
+              [](Array const &a) {
+                size_t const          n = a.degree();
+                py::array_t<uint32_t> result(a.size());
+                uint32_t *            out = result.mutable_data();
+                py::gil_scoped_release release;
+                std::vector<bool>      left, transverse(2 * n);
+                for (size_t i = 0; i < a.size(); ++i) {
+                  transverse_blocks(a.data(i), n, left, transverse.begin());
+                  out[i] = std::count(
+                      transverse.cbegin(), transverse.cend(), true);
+                }
+                return result;
+              },
+              R"pbdoc(
+                Returns the array of the ranks of the bipartitions, i.e. the
+                numbers of their transverse blocks.
+
+                :Parameters: None
+                :return: A ``numpy.ndarray`` of dtype ``uint32``.
+              )pbdoc")
+          .def(
+              "transverse_blocks",
+              [](Array const &a) {
+                size_t const      n = a.degree();
+                py::array_t<bool> result({a.size(), 2 * n});
+                bool *            out = result.mutable_data();
+                py::gil_scoped_release release;
+                std::vector<bool>      left;
+                for (size_t i = 0; i < a.size(); ++i) {
+                  transverse_blocks(a.data(i), n, left, out + i * 2 * n);
+                }
+                return result;
+              },
+              R"pbdoc(
+                Returns the 2-dimensional array whose entry in row ``i`` and
+                column ``j`` is ``True`` if the block with index ``j`` of the
+                ``i``-th bipartition is transverse, and ``False`` if not. The
+                array has twice as many columns as :py:meth:`degree`, and the
+                entries of the columns that are not the index of a block are
+                ``False``.
+
+                :Parameters: None
+                :return: A ``numpy.ndarray`` of dtype ``bool``.
+              )pbdoc");
+    }
+  }  // namespace
+
+  void init_element_array(py::module &m) {
+    bind_element_array<Transf<0, uint8_t>>(m, "Transf1");
+    bind_element_array<Transf<0, uint16_t>>(m, "Transf2");
+    bind_element_array<Transf<0, uint32_t>>(m, "Transf4");
+    bind_element_array<PPerm<0, uint8_t>>(m, "PPerm1");
+    bind_element_array<PPerm<0, uint16_t>>(m, "PPerm2");
+    bind_element_array<PPerm<0, uint32_t>>(m, "PPerm4");
+    bind_element_array<Perm<0, uint8_t>>(m, "Perm1");
+    bind_element_array<Perm<0, uint16_t>>(m, "Perm2");
+    bind_element_array<Perm<0, uint32_t>>(m, "Perm4");
+    auto bipart = bind_element_array<Bipartition>(m, "Bipartition");
+    bind_bipartition_array(bipart);
+    bind_element_array<PBR>(m, "PBR");
+  }
+}  // namespace libsemigroups
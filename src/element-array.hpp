@@ -0,0 +1,428 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the declaration of the class template ElementArray,
+// which stores a sequence of elements of the same degree contiguously, and
+// the traits describing how each kind of element is packed into it.
+
+#ifndef SRC_ELEMENT_ARRAY_HPP_
+#define SRC_ELEMENT_ARRAY_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <libsemigroups/libsemigroups.hpp>
+
+#include "parallel.hpp"
+
+namespace libsemigroups {
+
+  ////////////////////////////////////////////////////////////////////////
+  // Traits
+  ////////////////////////////////////////////////////////////////////////
+
+  // Every specialisation of ElementArrayTraits<T> must define:
+  //
+  // * word_type, the type of the words in which an element is packed;
+  // * scratch_type, the type of the temporary storage used by product;
+  // * words(n), the number of words used by an element of degree n;
+  // * pack(x, out), which writes the words of x to out;
+  // * unpack(in, n), which returns the element of degree n packed in in;
+  // * product(x, y, xy, n, scratch), which writes the words of the product
+  //   of the elements packed in x and y to xy.
+  template <typename T>
+  struct ElementArrayTraits;
+
+  namespace detail {
+    // Transformations, partial perms and perms are packed as their images,
+    // where the undefined points of a partial perm are UNDEFINED.
+    template <typename T, bool Partial>
+    struct PTransfArrayTraits {
+      using word_type = typename T::value_type;
+
+      struct scratch_type {};
+
+      static size_t words(size_t n) noexcept {
+        return n;
+      }
+
+      static void pack(T const &x, word_type *out) {
+        std::copy(x.cbegin(), x.cend(), out);
+      }
+
+      static T unpack(word_type const *in, size_t n) {
+        return T::make(std::vector<word_type>(in, in + n));
+      }
+
+      static void product(word_type const *x,
+                          word_type const *y,
+                          word_type *      xy,
+                          size_t           n,
+                          scratch_type &) noexcept {
+        word_type const undef = static_cast<word_type>(UNDEFINED);
+        for (size_t i = 0; i < n; ++i) {
+          xy[i] = (Partial && x[i] == undef) ? undef : y[x[i]];
+        }
+      }
+    };
+  }  // namespace detail
+
+  template <typename Scalar>
+  struct ElementArrayTraits<Transf<0, Scalar>>
+      : detail::PTransfArrayTraits<Transf<0, Scalar>, false> {};
+
+  template <typename Scalar>
+  struct ElementArrayTraits<PPerm<0, Scalar>>
+      : detail::PTransfArrayTraits<PPerm<0, Scalar>, true> {};
+
+  template <typename Scalar>
+  struct ElementArrayTraits<Perm<0, Scalar>>
+      : detail::PTransfArrayTraits<Perm<0, Scalar>, false> {};
+
+  // A bipartition of degree n is packed as the indices of the blocks of the
+  // points 0, ..., 2n - 1, i.e. its blocks lookup.
+  template <>
+  struct ElementArrayTraits<Bipartition> {
+    using word_type = uint32_t;
+
+    struct scratch_type {
+      std::vector<word_type> parent;
+      std::vector<word_type> label;
+    };
+
+    static size_t words(size_t n) noexcept {
+      return 2 * n;
+    }
+
+    static void pack(Bipartition const &x, word_type *out) {
+      std::copy(x.cbegin(), x.cend(), out);
+    }
+
+    static Bipartition unpack(word_type const *in, size_t n) {
+      return Bipartition::make(std::vector<word_type>(in, in + 2 * n));
+    }
+
+    // The lower points of x are identified with the upper points of y, and
+    // the blocks of x and y, numbered 0, ..., bx - 1 and bx, ..., bx + by - 1,
+    // are merged using union-find. The blocks of the product are then
+    // numbered in the order in which they first occur.
+    static void product(word_type const *x,
+                        word_type const *y,
+                        word_type *      xy,
+                        size_t           n,
+                        scratch_type &   scratch) {
+      if (n == 0) {
+        return;
+      }
+      word_type const bx = *std::max_element(x, x + 2 * n) + 1;
+      word_type const by = *std::max_element(y, y + 2 * n) + 1;
+      auto &          parent = scratch.parent;
+      parent.resize(bx + by);
+      std::iota(parent.begin(), parent.end(), 0);
+      auto find = [&parent](word_type i) {
+        while (parent[i] != i) {
+          parent[i] = parent[parent[i]];
+          i         = parent[i];
+        }
+        return i;
+      };
+      for (size_t i = 0; i < n; ++i) {
+        word_type const a = find(x[n + i]);
+        word_type const b = find(bx + y[i]);
+        if (a != b) {
+          parent[std::max(a, b)] = std::min(a, b);
+        }
+      }
+      auto &label = scratch.label;
+      label.assign(bx + by, static_cast<word_type>(UNDEFINED));
+      word_type next = 0;
+      for (size_t i = 0; i < 2 * n; ++i) {
+        word_type const r = (i < n ? find(x[i]) : find(bx + y[i]));
+        if (label[r] == static_cast<word_type>(UNDEFINED)) {
+          label[r] = next++;
+        }
+        xy[i] = label[r];
+      }
+    }
+  };
+
+  // A PBR of degree n is packed as the adjacency matrix of its 2n points,
+  // where every row is packed into 64-bit blocks.
+  template <>
+  struct ElementArrayTraits<PBR> {
+    using word_type = uint64_t;
+
+    struct scratch_type {
+      std::vector<bool>   seen;
+      std::vector<size_t> stack;
+    };
+
+    static size_t blocks(size_t n) noexcept {
+      return (2 * n + 63) / 64;
+    }
+
+    static size_t trailing_zeros(word_type w) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_ctzll(w);
+#else
+      size_t result = 0;
+      while ((w & 1) == 0) {
+        w >>= 1;
+        ++result;
+      }
+      return result;
+#endif
+    }
+
+    static size_t words(size_t n) noexcept {
+      return 2 * n * blocks(n);
+    }
+
+    static void pack(PBR const &x, word_type *out) {
+      size_t const n = x.degree();
+      size_t const b = blocks(n);
+      std::fill(out, out + words(n), 0);
+      for (size_t i = 0; i < 2 * n; ++i) {
+        for (auto j : x[i]) {
+          out[i * b + j / 64] |= word_type(1) << (j % 64);
+        }
+      }
+    }
+
+    static PBR unpack(word_type const *in, size_t n) {
+      size_t const                       b = blocks(n);
+      std::vector<std::vector<uint32_t>> adj(2 * n);
+      for (size_t i = 0; i < 2 * n; ++i) {
+        for (size_t j = 0; j < 2 * n; ++j) {
+          if ((in[i * b + j / 64] >> (j % 64)) & 1) {
+            adj[i].push_back(j);
+          }
+        }
+      }
+      return PBR::make(adj);
+    }
+
+    // There is an edge from i to j in the product if there is a path from i
+    // to j alternating between the edges of x and y, where the lower points
+    // of x are identified with the upper points of y. The point k of
+    // <seen> and <stack> is the lower point n + k of x if k < n, and the
+    // upper point k - n of y otherwise.
+    static void product(word_type const *x,
+                        word_type const *y,
+                        word_type *      xy,
+                        size_t           n,
+                        scratch_type &   scratch) {
+      size_t const b     = blocks(n);
+      auto &       seen  = scratch.seen;
+      auto &       stack = scratch.stack;
+      std::fill(xy, xy + words(n), 0);
+      for (size_t i = 0; i < 2 * n; ++i) {
+        word_type *out = xy + i * b;
+        seen.assign(2 * n, false);
+        stack.clear();
+        // Follows the edges of x from the point p of x, if p_in_x is true,
+        // and of y from the point p of y otherwise.
+        auto follow = [&](size_t p, bool p_in_x) {
+          word_type const *row = (p_in_x ? x : y) + p * b;
+          for (size_t c = 0; c < b; ++c) {
+            for (word_type w = row[c]; w != 0; w &= w - 1) {
+              size_t const j = c * 64 + trailing_zeros(w);
+              if (p_in_x == (j < n)) {
+                out[j / 64] |= word_type(1) << (j % 64);
+              } else if (!seen[j]) {
+                seen[j] = true;
+                stack.push_back(j);
+              }
+            }
+          }
+        };
+        follow(i, i < n);
+        while (!stack.empty()) {
+          size_t const k = stack.back();
+          stack.pop_back();
+          if (k < n) {
+            follow(n + k, true);
+          } else {
+            follow(k - n, false);
+          }
+        }
+      }
+    }
+  };
+
+  ////////////////////////////////////////////////////////////////////////
+  // ElementArray
+  ////////////////////////////////////////////////////////////////////////
+
+  template <typename T>
+  class ElementArray {
+   public:
+    using element_type = T;
+    using traits_type  = ElementArrayTraits<T>;
+    using word_type    = typename traits_type::word_type;
+
+    explicit ElementArray(size_t degree)
+        : _degree(degree), _words(traits_type::words(degree)), _size(0) {}
+
+    ElementArray(ElementArray const &) = default;
+    ElementArray(ElementArray &&)      = default;
+    ElementArray &operator=(ElementArray const &) = default;
+    ElementArray &operator=(ElementArray &&) = default;
+
+    size_t degree() const noexcept {
+      return _degree;
+    }
+
+    size_t size() const noexcept {
+      return _size;
+    }
+
+    size_t words_per_element() const noexcept {
+      return _words;
+    }
+
+    word_type *data(size_t i) noexcept {
+      return _data.data() + i * _words;
+    }
+
+    word_type const *data(size_t i) const noexcept {
+      return _data.data() + i * _words;
+    }
+
+    void reserve(size_t n) {
+      _data.reserve(n * _words);
+    }
+
+    void resize(size_t n) {
+      _data.resize(n * _words);
+      _size = n;
+    }
+
+    void push_back(T const &x) {
+      validate_degree(x);
+      _data.resize(_data.size() + _words);
+      traits_type::pack(x, data(_size++));
+    }
+
+    void set(size_t i, T const &x) {
+      validate_degree(x);
+      traits_type::pack(x, data(i));
+    }
+
+    T at(size_t i) const {
+      return traits_type::unpack(data(i), _degree);
+    }
+
+    bool equal(size_t i, ElementArray const &that, size_t j) const noexcept {
+      return std::equal(data(i), data(i) + _words, that.data(j));
+    }
+
+    bool less(size_t i, size_t j) const noexcept {
+      return std::lexicographical_compare(
+          data(i), data(i) + _words, data(j), data(j) + _words);
+    }
+
+    size_t hash_value(size_t i) const noexcept {
+      size_t seed = _degree;
+      for (auto it = data(i); it < data(i) + _words; ++it) {
+        seed ^= std::hash<word_type>()(*it) + 0x9e3779b97f4a7c16 + (seed << 6)
+                + (seed >> 2);
+      }
+      return seed;
+    }
+
+    bool operator==(ElementArray const &that) const noexcept {
+      return _degree == that._degree && _size == that._size
+             && _data == that._data;
+    }
+
+    bool operator!=(ElementArray const &that) const noexcept {
+      return !(*this == that);
+    }
+
+    // Sets this to the array of the products x[i] * y[i]. The arrays x and y
+    // must have the same degree and size, and must not be this.
+    void product_inplace(ElementArray const &x,
+                         ElementArray const &y,
+                         size_t              number_of_threads) {
+      resize(x.size());
+      size_t const n = _degree;
+      detail::parallel_for(
+          _size, number_of_threads, [this, &x, &y, n](size_t f, size_t l) {
+            typename traits_type::scratch_type scratch;
+            for (size_t i = f; i < l; ++i) {
+              traits_type::product(x.data(i), y.data(i), data(i), n, scratch);
+            }
+          });
+    }
+
+    // Sorts the elements with respect to the lexicographic order on their
+    // packed representations.
+    void sort() {
+      std::vector<size_t> index(_size);
+      std::iota(index.begin(), index.end(), 0);
+      std::sort(index.begin(), index.end(), [this](size_t i, size_t j) {
+        return less(i, j);
+      });
+      std::vector<word_type> sorted;
+      sorted.reserve(_data.size());
+      for (auto i : index) {
+        sorted.insert(sorted.end(), data(i), data(i) + _words);
+      }
+      std::swap(_data, sorted);
+    }
+
+    // Removes all but the first of every run of equal consecutive elements.
+    void unique() {
+      if (_size == 0) {
+        return;
+      }
+      size_t next = 1;
+      for (size_t i = 1; i < _size; ++i) {
+        if (!equal(i, *this, next - 1)) {
+          // Until the first duplicate, every element is already in place.
+          if (next != i) {
+            std::copy(data(i), data(i) + _words, data(next));
+          }
+          ++next;
+        }
+      }
+      resize(next);
+    }
+
+   private:
+    void validate_degree(T const &x) const {
+      if (x.degree() != _degree) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "expected an element of degree %llu, found %llu",
+            static_cast<uint64_t>(_degree),
+            static_cast<uint64_t>(x.degree()));
+      }
+    }
+
+    size_t                 _degree;
+    size_t                 _words;
+    size_t                 _size;
+    std::vector<word_type> _data;
+  };
+}  // namespace libsemigroups
+
+#endif  // SRC_ELEMENT_ARRAY_HPP_
@@ -0,0 +1,498 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <pybind11/chrono.h>
+#include <pybind11/functional.h>
+#include <pybind11/numpy.h>
+#include <pybind11/operators.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <libsemigroups/libsemigroups.hpp>
+
+#include "element-array.hpp"
+#include "main.hpp"
+#include "packed-bipart.hpp"
+#include "packed-bmat.hpp"
+#include "packed-pbr.hpp"
+
+namespace py = pybind11;
+
+namespace libsemigroups {
+  namespace {
+    // The containers are wrapped, so that pybind11 does not convert them to
+    // and from python sets and dicts.
+    template <typename T>
+    struct ElementSet {
+      ElementSet() = default;
+
+      ElementSet(ElementSet const &that) : elements(that.elements), mtx() {}
+
+      ElementSet(ElementSet &&that)
+          : elements(std::move(that.elements)), mtx() {}
+
+      bool operator==(ElementSet const &that) const {
+        return elements == that.elements;
+      }
+
+      std::unordered_set<T, Hash<T>, EqualTo<T>> elements;
+
+      // Every member function holds the GIL, except contains, which looks up
+      // the elements with the GIL released. So the functions that modify the
+      // elements hold this mutex exclusively, and contains holds it shared,
+      // and the elements are never modified while contains reads them.
+      mutable std::shared_timed_mutex mtx;
+    };
+
+    using WriteLock = std::unique_lock<std::shared_timed_mutex>;
+
+    using ReadLock = std::shared_lock<std::shared_timed_mutex>;
+
+    template <typename T>
+    struct ElementDict {
+      std::unordered_map<T, py::object, Hash<T>, EqualTo<T>> elements;
+    };
+
+    std::string repr(std::string const &pyclass_name, size_t n) {
+      return std::string("<") + pyclass_name + " of "
+             + detail::to_string(n) + " elements>";
+    }
+
+    template <typename T>
+    py::class_<ElementSet<T>> bind_element_set(py::module        &m,
+                                               std::string const &typestr) {
+      using Set                = ElementSet<T>;
+      std::string pyclass_name = typestr + "Set";
+      py::class_<Set> x(m,
+                        pyclass_name.c_str(),
+                        R"pbdoc(
+        A set of elements, which are hashed and compared in C++, rather
+        than by calling their ``__hash__`` and ``__eq__`` methods.
+      )pbdoc");
+
+      x.attr("element_type") = m.attr(typestr.c_str());
+
+      x.def(py::init<>())
+          .def(py::init<Set const &>())
+          .def(py::init([](std::vector<T> const &xs) {
+                 Set result;
+                 result.elements.insert(xs.cbegin(), xs.cend());
+                 return result;
+               }),
+               py::arg("xs"),
+               R"pbdoc(
+                 Constructs a set containing the elements in the list ``xs``.
+
+                 :param xs: the elements.
+                 :type xs: list
+               )pbdoc")
+          .def(py::self == py::self)
+          .def(py::self != py::self)
+          .def("__len__", [](Set const &s) { return s.elements.size(); })
+          .def("__contains__",
+               [](Set const &s, T const &y) {
+                 return s.elements.find(y) != s.elements.cend();
+               })
+          .def("__contains__", [](Set const &, py::object) { return false; })
+          .def(
+              "__iter__",
+              [](Set const &s) {
+                return py::make_iterator<py::return_value_policy::copy>(
+                    s.elements.cbegin(), s.elements.cend());
+              },
+              py::keep_alive<0, 1>())
+          .def(
+              "add",
+              [](Set &s, T const &y) {
+                WriteLock lock(s.mtx);
+                s.elements.insert(y);
+              },
+              py::arg("x"),
+              R"pbdoc(
+                Adds the element ``x``, if it does not already belong to
+                ``self``.
+
+                :param x: the element.
+                :type x: element_type
+
+                :return: (None)
+              )pbdoc")
+          .def(
+              "discard",
+              [](Set &s, T const &y) {
+                WriteLock lock(s.mtx);
+                s.elements.erase(y);
+              },
+              py::arg("x"),
+              R"pbdoc(
+                Removes the element ``x``, if it belongs to ``self``.
+
+                :param x: the element.
+                :type x: element_type
+
+                :return: (None)
+              )pbdoc")
+          .def(
+              "remove",
+              [](Set &s, T const &y) {
+                WriteLock lock(s.mtx);
+                if (s.elements.erase(y) == 0) {
+                  throw py::key_error();
+                }
+              },
+              py::arg("x"),
+              R"pbdoc(
+                Removes the element ``x``.
+
+                :param x: the element.
+                :type x: element_type
+
+                :return: (None)
+
+                :raises KeyError: if ``x`` does not belong to ``self``.
+              )pbdoc")
+          .def(
+              "update",
+              [](Set &s, std::vector<T> const &xs) {
+                WriteLock lock(s.mtx);
+                s.elements.insert(xs.cbegin(), xs.cend());
+              },
+              py::arg("xs"),
+              R"pbdoc(
+                Adds the elements in the list ``xs``.
+
+                :param xs: the elements.
+                :type xs: list
+
+                :return: (None)
+              )pbdoc")
+          .def(
+              "contains",
+              [](Set const &s, std::vector<T> const &xs) {
+                py::array_t<bool>      result(xs.size());
+                bool *                 out = result.mutable_data();
+                py::gil_scoped_release release;
+                ReadLock               lock(s.mtx);
+                for (size_t i = 0; i < xs.size(); ++i) {
+                  out[i] = (s.elements.find(xs[i]) != s.elements.cend());
+                }
+                return result;
+              },
+              py::arg("xs"),
+              R"pbdoc(
+                Returns the array whose ``i``-th entry is ``True`` if
+                ``xs[i]`` belongs to ``self``, and ``False`` if not.
+
+                :param xs: the elements.
+                :type xs: list
+
+                :return: A ``numpy.ndarray`` of dtype ``bool``.
+              )pbdoc")
+          .def("clear",
+               [](Set &s) {
+                 WriteLock lock(s.mtx);
+                 s.elements.clear();
+               })
+          .def(
+              "to_list",
+              [](Set const &s) {
+                return std::vector<T>(s.elements.cbegin(), s.elements.cend());
+              },
+              R"pbdoc(
+                Returns the list of the elements, in an unspecified order.
+
+                :Parameters: None
+                :return: A ``list``.
+              )pbdoc")
+          .def("__repr__", [pyclass_name](Set const &s) {
+            return repr(pyclass_name, s.elements.size());
+          });
+      return x;
+    }
+
+    template <typename T>
+    py::class_<ElementDict<T>> bind_element_dict(py::module        &m,
+                                                 std::string const &typestr) {
+      using Dict               = ElementDict<T>;
+      std::string pyclass_name = typestr + "Dict";
+      py::class_<Dict> x(m,
+                         pyclass_name.c_str(),
+                         R"pbdoc(
+        A dictionary whose keys are elements, which are hashed and compared
+        in C++, rather than by calling their ``__hash__`` and ``__eq__``
+        methods. The values can be arbitrary python objects.
+      )pbdoc");
+
+      x.attr("element_type") = m.attr(typestr.c_str());
+
+      x.def(py::init<>())
+          .def(py::init<Dict const &>())
+          .def("__len__", [](Dict const &d) { return d.elements.size(); })
+          .def("__contains__",
+               [](Dict const &d, T const &y) {
+                 return d.elements.find(y) != d.elements.cend();
+               })
+          .def("__contains__", [](Dict const &, py::object) { return false; })
+          .def("__getitem__",
+               [](Dict const &d, T const &y) {
+                 auto it = d.elements.find(y);
+                 if (it == d.elements.cend()) {
+                   throw py::key_error();
+                 }
+                 return it->second;
+               })
+          .def("__setitem__",
+               [](Dict &d, T const &y, py::object val) {
+                 d.elements[y] = val;
+               })
+          .def("__delitem__",
+               [](Dict &d, T const &y) {
+                 if (d.elements.erase(y) == 0) {
+                   throw py::key_error();
+                 }
+               })
+          .def(
+              "__iter__",
+              [](Dict const &d) {
+                return py::make_key_iterator<py::return_value_policy::copy>(
+                    d.elements.cbegin(), d.elements.cend());
+              },
+              py::keep_alive<0, 1>())
+          .def(
+              "get",
+              [](Dict const &d, T const &y, py::object val) {
+                auto it = d.elements.find(y);
+                return it == d.elements.cend() ? val : it->second;
+              },
+              py::arg("x"),
+              py::arg("default") = py::none(),
+              R"pbdoc(
+                Returns the value of the key ``x``, or ``default`` if ``x``
+                is not a key.
+
+                :param x: the key.
+                :type x: element_type
+                :param default: the default value (default: ``None``).
+                :type default: object
+
+                :return: An ``object``.
+              )pbdoc")
+          .def(
+              "contains",
+              [](Dict const &d, std::vector<T> const &xs) {
+                py::array_t<bool> result(xs.size());
+                bool *            out = result.mutable_data();
+                for (size_t i = 0; i < xs.size(); ++i) {
+                  out[i] = (d.elements.find(xs[i]) != d.elements.cend());
+                }
+                return result;
+              },
+              py::arg("xs"),
+              R"pbdoc(
+                Returns the array whose ``i``-th entry is ``True`` if
+                ``xs[i]`` is a key of ``self``, and ``False`` if not.
+
+                :param xs: the keys.
+                :type xs: list
+
+                :return: A ``numpy.ndarray`` of dtype ``bool``.
+              )pbdoc")
+          .def(
+              "keys",
+              [](Dict const &d) {
+                std::vector<T> result;
+                result.reserve(d.elements.size());
+                for (auto const &kv : d.elements) {
+                  result.push_back(kv.first);
+                }
+                return result;
+              },
+              R"pbdoc(
+                Returns the list of the keys, in an unspecified order.
+
+                :Parameters: None
+                :return: A ``list``.
+              )pbdoc")
+          .def(
+              "values",
+              [](Dict const &d) {
+                py::list result;
+                for (auto const &kv : d.elements) {
+                  result.append(kv.second);
+                }
+                return result;
+              },
+              R"pbdoc(
+                Returns the list of the values, in the same order as
+                :py:meth:`keys`.
+
+                :Parameters: None
+                :return: A ``list``.
+              )pbdoc")
+          .def(
+              "items",
+              [](Dict const &d) {
+                py::list result;
+                for (auto const &kv : d.elements) {
+                  result.append(py::make_tuple(kv.first, kv.second));
+                }
+                return result;
+              },
+              R"pbdoc(
+                Returns the list of the pairs ``(key, value)``, in the same
+                order as :py:meth:`keys`.
+
+                :Parameters: None
+                :return: A ``list``.
+              )pbdoc")
+          .def("clear", [](Dict &d) { d.elements.clear(); })
+          .def("__repr__", [pyclass_name](Dict const &d) {
+            return repr(pyclass_name, d.elements.size());
+          });
+      return x;
+    }
+
+    template <typename T>
+    void bind_array_methods(py::class_<ElementSet<T>> &,
+                            py::class_<ElementDict<T>> &,
+                            std::false_type) {}
+
+    // Adds the methods for elements with an ElementArray type, which insert
+    // or look up all of the elements of an array at once.
+    template <typename T>
+    void bind_array_methods(py::class_<ElementSet<T>>  &x,
+                            py::class_<ElementDict<T>> &y,
+                            std::true_type) {
+      using Array = ElementArray<T>;
+      using Set   = ElementSet<T>;
+      using Dict  = ElementDict<T>;
+
+      x.def(py::init([](Array const &a) {
+              Set result;
+              result.elements.reserve(a.size());
+              for (size_t i = 0; i < a.size(); ++i) {
+                result.elements.insert(a.at(i));
+              }
+              return result;
+            }),
+            py::arg("a"))
+          .def(
+              "update",
+              [](Set &s, Array const &a) {
+                WriteLock lock(s.mtx);
+                for (size_t i = 0; i < a.size(); ++i) {
+                  s.elements.insert(a.at(i));
+                }
+              },
+              py::arg("a"))
+          .def(
+              "contains",
+              [](Set const &s, Array const &a) {
+                py::array_t<bool>      result(a.size());
+                bool *                 out = result.mutable_data();
+                py::gil_scoped_release release;
+                ReadLock               lock(s.mtx);
+                for (size_t i = 0; i < a.size(); ++i) {
+                  out[i] = (s.elements.find(a.at(i)) != s.elements.cend());
+                }
+                return result;
+              },
+              py::arg("a"));
+
+      y.def(
+          "contains",
+          [](Dict const &d, Array const &a) {
+            py::array_t<bool> result(a.size());
+            bool *            out = result.mutable_data();
+            for (size_t i = 0; i < a.size(); ++i) {
+              out[i] = (d.elements.find(a.at(i)) != d.elements.cend());
+            }
+            return result;
+          },
+          py::arg("a"));
+    }
+
+    template <typename T, typename HasArray = std::false_type>
+    void bind_element_set_and_dict(py::module &m, std::string const &typestr) {
+      auto x = bind_element_set<T>(m, typestr);
+      auto y = bind_element_dict<T>(m, typestr);
+      bind_array_methods(x, y, HasArray());
+    }
+  }  // namespace
+
+  void init_element_set(py::module &m) {
+    bind_element_set_and_dict<LeastTransf<16>>(m, "Transf16");
+    bind_element_set_and_dict<Transf<0, uint8_t>, std::true_type>(m, "Transf1");
+    bind_element_set_and_dict<Transf<0, uint16_t>, std::true_type>(m,
+                                                                   "Transf2");
+    bind_element_set_and_dict<Transf<0, uint32_t>, std::true_type>(m,
+                                                                   "Transf4");
+    bind_element_set_and_dict<LeastPPerm<16>>(m, "PPerm16");
+    bind_element_set_and_dict<PPerm<0, uint8_t>, std::true_type>(m, "PPerm1");
+    bind_element_set_and_dict<PPerm<0, uint16_t>, std::true_type>(m, "PPerm2");
+    bind_element_set_and_dict<PPerm<0, uint32_t>, std::true_type>(m, "PPerm4");
+    bind_element_set_and_dict<LeastPerm<16>>(m, "Perm16");
+    bind_element_set_and_dict<Perm<0, uint8_t>, std::true_type>(m, "Perm1");
+    bind_element_set_and_dict<Perm<0, uint16_t>, std::true_type>(m, "Perm2");
+    bind_element_set_and_dict<Perm<0, uint32_t>, std::true_type>(m, "Perm4");
+    bind_element_set_and_dict<Bipartition, std::true_type>(m, "Bipartition");
+    bind_element_set_and_dict<PBR, std::true_type>(m, "PBR");
+    bind_element_set_and_dict<BMat8>(m, "BMat8");
+    bind_element_set_and_dict<PackedBMat>(m, "PackedBMat");
+    bind_element_set_and_dict<PackedPBR>(m, "PackedPBR");
+    bind_element_set_and_dict<PackedBipartition>(m, "PackedBipartition");
+
+    bind_element_set_and_dict<BMat<>>(m, "BMat");
+    bind_element_set_and_dict<IntMat<>>(m, "IntMat");
+    bind_element_set_and_dict<MaxPlusMat<>>(m, "MaxPlusMat");
+    bind_element_set_and_dict<MinPlusMat<>>(m, "MinPlusMat");
+    bind_element_set_and_dict<ProjMaxPlusMat<>>(m, "ProjMaxPlusMat");
+    bind_element_set_and_dict<MaxPlusTruncMat<>>(m, "MaxPlusTruncMat");
+    bind_element_set_and_dict<MinPlusTruncMat<>>(m, "MinPlusTruncMat");
+    bind_element_set_and_dict<NTPMat<>>(m, "NTPMat");
+
+    // The matrices whose dimension is known at compile time, see matrix.py.
+    bind_element_set_and_dict<BMat<2>>(m, "BMat2");
+    bind_element_set_and_dict<BMat<3>>(m, "BMat3");
+    bind_element_set_and_dict<BMat<4>>(m, "BMat4");
+    bind_element_set_and_dict<BMat<5>>(m, "BMat5");
+    bind_element_set_and_dict<BMat<6>>(m, "BMat6");
+    bind_element_set_and_dict<IntMat<2>>(m, "IntMat2");
+    bind_element_set_and_dict<IntMat<3>>(m, "IntMat3");
+    bind_element_set_and_dict<IntMat<4>>(m, "IntMat4");
+    bind_element_set_and_dict<IntMat<5>>(m, "IntMat5");
+    bind_element_set_and_dict<IntMat<6>>(m, "IntMat6");
+    bind_element_set_and_dict<MaxPlusMat<2>>(m, "MaxPlusMat2");
+    bind_element_set_and_dict<MaxPlusMat<3>>(m, "MaxPlusMat3");
+    bind_element_set_and_dict<MaxPlusMat<4>>(m, "MaxPlusMat4");
+    bind_element_set_and_dict<MaxPlusMat<5>>(m, "MaxPlusMat5");
+    bind_element_set_and_dict<MaxPlusMat<6>>(m, "MaxPlusMat6");
+    bind_element_set_and_dict<MinPlusMat<2>>(m, "MinPlusMat2");
+    bind_element_set_and_dict<MinPlusMat<3>>(m, "MinPlusMat3");
+    bind_element_set_and_dict<MinPlusMat<4>>(m, "MinPlusMat4");
+    bind_element_set_and_dict<MinPlusMat<5>>(m, "MinPlusMat5");
+    bind_element_set_and_dict<MinPlusMat<6>>(m, "MinPlusMat6");
+  }
+}  // namespace libsemigroups
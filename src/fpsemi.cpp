@@ -18,6 +18,10 @@
 
 // Status: complete
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include <pybind11/chrono.h>
 #include <pybind11/functional.h>
 #include <pybind11/operators.h>
@@ -32,8 +36,54 @@ namespace py = pybind11;
 
 namespace libsemigroups {
   using rule_type = FpSemigroupInterface::rule_type;
+
+  namespace {
+    using Kambites_ = fpsemigroup::Kambites<>;
+
+    // FpSemigroup's race does not include Kambites' algorithm, and the race
+    // cannot be modified from outside, and so we store a Kambites instance as
+    // an attribute of the Python object. This instance is created lazily, and
+    // discarded by every binding that modifies the alphabet or the rules, see
+    // invalidate_kambites.
+    std::shared_ptr<Kambites_> kambites(py::object self) {
+      if (py::hasattr(self, "_kambites")) {
+        return self.attr("_kambites").cast<std::shared_ptr<Kambites_>>();
+      }
+      auto const &fp = self.cast<FpSemigroup const &>();
+      if (fp.alphabet().empty()) {
+        return nullptr;
+      }
+      auto k = std::make_shared<Kambites_>();
+      k->set_alphabet(fp.alphabet());
+      k->add_rules(std::vector<rule_type>(fp.cbegin_rules(), fp.cend_rules()));
+      self.attr("_kambites") = k;
+      return k;
+    }
+
+    // Returns a function calling the member function fn of FpSemigroup, and
+    // then discarding the stored Kambites instance, if any.
+    template <typename Base, typename... Args>
+    auto invalidate_kambites(void (Base::*fn)(Args...)) {
+      return [fn](py::object self, Args... args) {
+        (self.cast<FpSemigroup &>().*fn)(std::forward<Args>(args)...);
+        if (py::hasattr(self, "_kambites")) {
+          py::delattr(self, "_kambites");
+        }
+      };
+    }
+
+    // Returns nullptr if Kambites' algorithm is not applicable.
+    std::shared_ptr<Kambites_> small_overlap_kambites(py::object self) {
+      auto k = kambites(self);
+      if (k == nullptr || k->small_overlap_class() < 4) {
+        return nullptr;
+      }
+      return k;
+    }
+  }  // namespace
+
   void init_fpsemi(py::module &m) {
-    py::class_<FpSemigroup>(m, "FpSemigroup")
+    py::class_<FpSemigroup>(m, "FpSemigroup", py::dynamic_attr())
         .def(py::init<>())
         .def(py::init<std::shared_ptr<FroidurePinBase>>())
         .def(py::init<FpSemigroup const &>())
@@ -81,7 +131,8 @@ namespace libsemigroups {
                :Returns: (None)
                )pbdoc")
         .def("set_alphabet",
-             py::overload_cast<size_t>(&FpSemigroup::set_alphabet),
+             invalidate_kambites(
+                 py::overload_cast<size_t>(&FpSemigroup::set_alphabet)),
              py::arg("n"),
              R"pbdoc(
                Set the size of the alphabet.
@@ -91,7 +142,8 @@ namespace libsemigroups {
                :Returns: (None)
                )pbdoc")
         .def("set_alphabet",
-             py::overload_cast<std::string const &>(&FpSemigroup::set_alphabet),
+             invalidate_kambites(py::overload_cast<std::string const &>(
+                 &FpSemigroup::set_alphabet)),
              py::arg("a"),
              R"pbdoc(
                Set the alphabet of the finitely presented semigroup.
@@ -121,7 +173,8 @@ namespace libsemigroups {
                :Returns: A string.
                )pbdoc")
         .def("set_identity",
-             py::overload_cast<letter_type>(&FpSemigroup::set_identity),
+             invalidate_kambites(
+                 py::overload_cast<letter_type>(&FpSemigroup::set_identity)),
              py::arg("id"),
              R"pbdoc(
                Set a string of length 1 belonging to
@@ -133,7 +186,8 @@ namespace libsemigroups {
                :Returns: (None)
                )pbdoc")
         .def("set_identity",
-             py::overload_cast<std::string const &>(&FpSemigroup::set_identity),
+             invalidate_kambites(py::overload_cast<std::string const &>(
+                 &FpSemigroup::set_identity)),
              py::arg("id"),
              R"pbdoc(
                Set a string of length 1 belonging to
@@ -152,7 +206,7 @@ namespace libsemigroups {
                :return: A string.
                )pbdoc")
         .def("set_inverses",
-             &FpSemigroup::set_inverses,
+             invalidate_kambites(&FpSemigroup::set_inverses),
              py::arg("a"),
              R"pbdoc(
                Set the inverses of letters in :py:meth:`~FpSemigroup.alphabet`.
@@ -171,7 +225,8 @@ namespace libsemigroups {
                :return: A string.
                )pbdoc")
         .def("add_rule",
-             py::overload_cast<relation_type>(&FpSemigroup::add_rule),
+             invalidate_kambites(
+                 py::overload_cast<relation_type>(&FpSemigroup::add_rule)),
              py::arg("rel"),
              R"pbdoc(
                Add a rule.
@@ -181,7 +236,8 @@ namespace libsemigroups {
                :Returns: (None)
                )pbdoc")
         .def("add_rule",
-             py::overload_cast<rule_type>(&FpSemigroup::add_rule),
+             invalidate_kambites(
+                 py::overload_cast<rule_type>(&FpSemigroup::add_rule)),
              py::arg("rel"),
              R"pbdoc(
                Add a rule.
@@ -191,8 +247,9 @@ namespace libsemigroups {
                :Returns: (None)
                )pbdoc")
         .def("add_rule",
-             py::overload_cast<std::string const &, std::string const &>(
-                 &FpSemigroup::add_rule),
+             invalidate_kambites(
+                 py::overload_cast<std::string const &, std::string const &>(
+                     &FpSemigroup::add_rule)),
              py::arg("u"),
              py::arg("v"),
              R"pbdoc(
@@ -204,8 +261,9 @@ namespace libsemigroups {
                :Returns: (None)
                )pbdoc")
         .def("add_rule",
-             py::overload_cast<word_type const &, word_type const &>(
-                 &FpSemigroup::add_rule),
+             invalidate_kambites(
+                 py::overload_cast<word_type const &, word_type const &>(
+                     &FpSemigroup::add_rule)),
              py::arg("u"),
              py::arg("v"),
              R"pbdoc(
@@ -217,7 +275,8 @@ namespace libsemigroups {
                :Returns: (None)
                )pbdoc")
         .def("add_rules",
-             py::overload_cast<FroidurePinBase &>(&FpSemigroup::add_rules),
+             invalidate_kambites(
+                 py::overload_cast<FroidurePinBase &>(&FpSemigroup::add_rules)),
              py::arg("S"),
              R"pbdoc(
                Add the rules of a finite presentation for S to this.
@@ -227,8 +286,9 @@ namespace libsemigroups {
                :Returns: (None)
                )pbdoc")
         .def("add_rules",
-             py::overload_cast<std::vector<rule_type> const &>(
-                 &FpSemigroup::add_rules),
+             invalidate_kambites(
+                 py::overload_cast<std::vector<rule_type> const &>(
+                     &FpSemigroup::add_rules)),
              py::arg("rels"),
              R"pbdoc(
                Add the rules in the given list to the finitely presented
@@ -382,32 +442,40 @@ namespace libsemigroups {
 
                :Returns: A list of integers.
                )pbdoc")
-        .def("equal_to",
-             py::overload_cast<std::string const &, std::string const &>(
-                 &FpSemigroup::equal_to),
-             py::arg("u"),
-             py::arg("v"),
-             R"pbdoc(
-               Check if two words represent the same element.
+        .def(
+            "equal_to",
+            [](py::object self, std::string const &u, std::string const &v) {
+              auto k = small_overlap_kambites(self);
+              return k != nullptr ? k->equal_to(u, v)
+                                  : self.cast<FpSemigroup &>().equal_to(u, v);
+            },
+            py::arg("u"),
+            py::arg("v"),
+            R"pbdoc(
+              Check if two words represent the same element.
 
-               :Parameters: - **u** (str) - the first word, must be a string over :py:meth:`~FpSemigroup.alphabet`.
-                            - **v** (str) - the second word, must be a string over :py:meth:`~FpSemigroup.alphabet`.
+              :Parameters: - **u** (str) - the first word, must be a string over :py:meth:`~FpSemigroup.alphabet`.
+                           - **v** (str) - the second word, must be a string over :py:meth:`~FpSemigroup.alphabet`.
 
-               :Returns: ``True`` if the strings ``u`` and ``v`` represent the same element of the finitely presented semigroup, and ``False`` otherwise.
-               )pbdoc")
-        .def("equal_to",
-             py::overload_cast<word_type const &, word_type const &>(
-                 &FpSemigroup::equal_to),
-             py::arg("u"),
-             py::arg("v"),
-             R"pbdoc(
-               Check if two words represent the same element.
+              :Returns: ``True`` if the strings ``u`` and ``v`` represent the same element of the finitely presented semigroup, and ``False`` otherwise.
+              )pbdoc")
+        .def(
+            "equal_to",
+            [](py::object self, word_type const &u, word_type const &v) {
+              auto k = small_overlap_kambites(self);
+              return k != nullptr ? k->equal_to(u, v)
+                                  : self.cast<FpSemigroup &>().equal_to(u, v);
+            },
+            py::arg("u"),
+            py::arg("v"),
+            R"pbdoc(
+              Check if two words represent the same element.
 
-               :Parameters: - **u** (List[int]) - the first word.
-                            - **v** (List[int]) - the second word.
+              :Parameters: - **u** (List[int]) - the first word.
+                           - **v** (List[int]) - the second word.
 
-               :Returns: ``True`` if the words ``u`` and ``v`` represent the same element of the finitely presented semigroup, and ``False`` otherwise.
-               )pbdoc")
+              :Returns: ``True`` if the words ``u`` and ``v`` represent the same element of the finitely presented semigroup, and ``False`` otherwise.
+              )pbdoc")
         .def("word_to_string",
              &FpSemigroup::word_to_string,
              py::arg("w"),
@@ -507,6 +575,34 @@ namespace libsemigroups {
 
                :return: A ``ToddCoxeter`` instance.
                )pbdoc")
+        .def(
+            "has_kambites",
+            [](py::object self) {
+              return small_overlap_kambites(self) != nullptr;
+            },
+            R"pbdoc(
+              Checks if a :py:class:`Kambites` instance is used to compute
+              :py:meth:`~FpSemigroup.equal_to` and
+              :py:meth:`~FpSemigroup.size`. This is the case if and only if
+              the presentation satisfies the small overlap condition
+              :math:`C(4)`, in which case these functions return immediately
+              rather than running every other algorithm in parallel. The
+              normal forms of :py:class:`Kambites` are lexicographically
+              least, rather than short-lex least, and so
+              :py:meth:`~FpSemigroup.normal_form` never uses it.
+
+              :return: A ``bool``.
+            )pbdoc")
+        .def(
+            "kambites",
+            [](py::object self) { return kambites(self); },
+            R"pbdoc(
+              Returns the :py:class:`Kambites` instance for the rules of the
+              finitely presented semigroup, or ``None`` if the alphabet is
+              empty.
+
+              :return: A :py:class:`Kambites` instance.
+            )pbdoc")
         .def("is_obviously_finite",
              &FpSemigroup::is_obviously_finite,
              R"pbdoc(
@@ -523,13 +619,18 @@ namespace libsemigroups {
 
                :return: A ``bool``.
                )pbdoc")
-        .def("size",
-             &FpSemigroup::size,
-             R"pbdoc(
-               Returns the size of the finitely presented semigroup.
+        .def(
+            "size",
+            [](py::object self) {
+              auto k = small_overlap_kambites(self);
+              return k != nullptr ? k->size()
+                                  : self.cast<FpSemigroup &>().size();
+            },
+            R"pbdoc(
+              Returns the size of the finitely presented semigroup.
 
-               :return: An ``int`` the value of which equals the size of this if this number is finite, or ``POSITIVE_INFINITY`` if this number is not finite.
-               )pbdoc")
+              :return: An ``int`` the value of which equals the size of this if this number is finite, or ``POSITIVE_INFINITY`` if this number is not finite.
+              )pbdoc")
         .def(
             "rules",
             [](FpSemigroup const &fp) {
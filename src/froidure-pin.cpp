@@ -16,8 +16,15 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
 #include <pybind11/chrono.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -25,7 +32,13 @@
 #include <libsemigroups/libsemigroups.hpp>
 
 #include "doc-strings.hpp"
+#include "element-array.hpp"
+#include "frozen-froidure-pin.hpp"
 #include "main.hpp"
+#include "packed-bipart.hpp"
+#include "packed-bmat.hpp"
+#include "packed-pbr.hpp"
+#include "parallel.hpp"
 
 namespace libsemigroups {
   namespace {
@@ -59,6 +72,455 @@ namespace libsemigroups {
       return out.str();
     }
 
+    ////////////////////////////////////////////////////////////////////////
+    // Batched lookups
+    ////////////////////////////////////////////////////////////////////////
+
+    // The element types that have an ElementArray, see element-array.cpp.
+    template <typename T>
+    struct HasElementArray : std::false_type {};
+
+    template <typename Scalar>
+    struct HasElementArray<Transf<0, Scalar>> : std::true_type {};
+
+    template <typename Scalar>
+    struct HasElementArray<PPerm<0, Scalar>> : std::true_type {};
+
+    template <typename Scalar>
+    struct HasElementArray<Perm<0, Scalar>> : std::true_type {};
+
+    template <>
+    struct HasElementArray<Bipartition> : std::true_type {};
+
+    template <>
+    struct HasElementArray<PBR> : std::true_type {};
+
+    // Copies of the elements in a list, so that they can be used without the
+    // GIL, even if the list or its elements are modified, or freed, by
+    // another thread in the meantime.
+    template <typename T>
+    class ListElements {
+     public:
+      explicit ListElements(py::list const &xs) : _elts() {
+        _elts.reserve(xs.size());
+        for (auto const &x : xs) {
+          _elts.push_back(x.cast<T const &>());
+        }
+      }
+
+      size_t size() const noexcept {
+        return _elts.size();
+      }
+
+      T const &operator()(size_t i) const noexcept {
+        return _elts[i];
+      }
+
+     private:
+      std::vector<T> _elts;
+    };
+
+    // A copy of an ElementArray, for the same reason as in ListElements,
+    // whose elements are unpacked one at a time by the thread looking them
+    // up.
+    template <typename T>
+    class ArrayElements {
+     public:
+      explicit ArrayElements(ElementArray<T> const &a) : _a(a) {}
+
+      size_t size() const noexcept {
+        return _a.size();
+      }
+
+      T operator()(size_t i) const {
+        return _a.at(i);
+      }
+
+     private:
+      ElementArray<T> const _a;
+    };
+
+    // Sets out[i] to lookup(xs(i)) for every i, using <number_of_threads>
+    // threads at once, none of which uses Python. The function lookup must
+    // not modify anything.
+    template <typename Lookup, typename Elements>
+    void parallel_positions(Lookup const &  lookup,
+                            Elements const &xs,
+                            size_t          number_of_threads,
+                            uint64_t *      out) {
+      detail::parallel_for(
+          xs.size(),
+          number_of_threads,
+          [&lookup, &xs, out](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+              out[i] = lookup(xs(i));
+            }
+          });
+    }
+
+    // Returns the array whose i-th entry is lookup(xs(i)). The GIL is held
+    // throughout, so that no other Python thread can modify the FroidurePin
+    // which lookup reads while the elements are looked up in parallel. There
+    // is no other way to modify a FroidurePin, since none of its bindings
+    // releases the GIL.
+    template <typename Lookup, typename Elements>
+    py::array_t<uint64_t> batched_positions(Lookup const &  lookup,
+                                            Elements const &xs,
+                                            size_t          number_of_threads) {
+      py::array_t<uint64_t> result(xs.size());
+      parallel_positions(lookup, xs, number_of_threads, result.mutable_data());
+      return result;
+    }
+
+    // As batched_positions, but the GIL is released while the elements are
+    // looked up, and so lookup must only read things that cannot be
+    // modified, such as a FrozenFroidurePin.
+    template <typename Lookup, typename Elements>
+    py::array_t<uint64_t>
+    batched_positions_without_gil(Lookup const &  lookup,
+                                  Elements const &xs,
+                                  size_t          number_of_threads) {
+      py::array_t<uint64_t> result(xs.size());
+      uint64_t *            out = result.mutable_data();
+      {
+        py::gil_scoped_release release;
+        parallel_positions(lookup, xs, number_of_threads, out);
+      }
+      return result;
+    }
+
+    // Replaces every UNDEFINED entry of <pos> by the position of the
+    // corresponding element of <xs>, using FroidurePin::position, which
+    // only enumerates S until the element is found. This is done by a single
+    // thread holding the GIL, since S may be modified.
+    template <typename Class, typename Elements>
+    void find_missing_positions(Class &                S,
+                                Elements const &       xs,
+                                py::array_t<uint64_t> &pos) {
+      uint64_t *out = pos.mutable_data();
+      for (size_t i = 0; i < xs.size(); ++i) {
+        if (out[i] == static_cast<uint64_t>(UNDEFINED)) {
+          out[i] = S.position(xs(i));
+        }
+      }
+    }
+
+    py::array_t<bool> batched_contains(py::array_t<uint64_t> const &pos) {
+      py::array_t<bool> result(pos.size());
+      uint64_t const *  in  = pos.data();
+      bool *            out = result.mutable_data();
+      std::transform(in, in + pos.size(), out, [](uint64_t i) {
+        return i != static_cast<uint64_t>(UNDEFINED);
+      });
+      return result;
+    }
+
+    char const *const batched_current_positions_doc = R"pbdoc(
+      Returns the array whose ``i``-th entry is
+      :py:meth:`current_position` of ``xs[i]``, without enumerating
+      ``self``. The elements are hashed and looked up by
+      ``number_of_threads`` threads at once.
+
+      :param xs: the elements.
+      :type xs: list or ElementArray
+      :param number_of_threads: the number of threads (default: ``1``).
+      :type number_of_threads: int
+
+      :return: A ``numpy.ndarray`` of dtype ``uint64``.
+    )pbdoc";
+
+    char const *const batched_positions_doc = R"pbdoc(
+      Returns the array whose ``i``-th entry is the position of ``xs[i]``, or
+      :py:obj:`UNDEFINED` if ``xs[i]`` is not an element. The elements are
+      hashed and looked up by ``number_of_threads`` threads at once, in the
+      elements enumerated so far. The elements not found are
+      then looked up one at a time using :py:meth:`position`, and so, as for
+      :py:meth:`position`, ``self`` is only enumerated until every element
+      of ``xs`` is found, and is fully enumerated if any of them is not an
+      element.
+
+      :param xs: the elements.
+      :type xs: list or ElementArray
+      :param number_of_threads: the number of threads (default: ``1``).
+      :type number_of_threads: int
+
+      :return: A ``numpy.ndarray`` of dtype ``uint64``.
+    )pbdoc";
+
+    char const *const batched_sorted_positions_doc = R"pbdoc(
+      Returns the array whose ``i``-th entry is :py:meth:`sorted_position` of
+      ``xs[i]``, or :py:obj:`UNDEFINED` if ``xs[i]`` is not an element. As
+      for :py:meth:`sorted_position`, ``self`` is fully enumerated first,
+      and so this function does not return if ``self`` is infinite. The
+      elements are then hashed and looked up by ``number_of_threads``
+      threads at once.
+
+      :param xs: the elements.
+      :type xs: list or ElementArray
+      :param number_of_threads: the number of threads (default: ``1``).
+      :type number_of_threads: int
+
+      :return: A ``numpy.ndarray`` of dtype ``uint64``.
+    )pbdoc";
+
+    char const *const batched_contains_doc = R"pbdoc(
+      Returns the array whose ``i``-th entry is ``True`` if ``xs[i]`` is an
+      element, and ``False`` if not. The elements are looked up, and
+      ``self`` is enumerated, as in :py:meth:`positions`.
+
+      :param xs: the elements.
+      :type xs: list or ElementArray
+      :param number_of_threads: the number of threads (default: ``1``).
+      :type number_of_threads: int
+
+      :return: A ``numpy.ndarray`` of dtype ``bool``.
+    )pbdoc";
+
+    // Binds the batched lookups in a FroidurePin of the elements in a Batch,
+    // such as a list or an ElementArray. The FroidurePin is only modified by
+    // find_missing_positions and run, after or before the elements are looked
+    // up in parallel, and other threads are prevented from modifying it in
+    // the meantime by holding the GIL, see batched_positions.
+    template <typename Class,
+              typename Elements,
+              typename Batch,
+              typename PyClass>
+    void bind_batched_lookups(PyClass &x) {
+      using const_reference = typename Class::const_reference;
+      x.def(
+           "current_positions",
+           [](Class const &S, Batch const &xs, size_t number_of_threads) {
+             return batched_positions(
+                 [&S](const_reference y) { return S.current_position(y); },
+                 Elements(xs),
+                 number_of_threads);
+           },
+           py::arg("xs"),
+           py::arg("number_of_threads") = 1,
+           batched_current_positions_doc)
+          .def(
+              "positions",
+              [](Class &S, Batch const &xs, size_t number_of_threads) {
+                Elements ys(xs);
+                auto     result = batched_positions(
+                    [&S](const_reference y) { return S.current_position(y); },
+                    ys,
+                    number_of_threads);
+                find_missing_positions(S, ys, result);
+                return result;
+              },
+              py::arg("xs"),
+              py::arg("number_of_threads") = 1,
+              batched_positions_doc)
+          .def(
+              "sorted_positions",
+              [](Class &S, Batch const &xs, size_t number_of_threads) {
+                S.run();
+                auto result = batched_positions(
+                    [&S](const_reference y) { return S.current_position(y); },
+                    Elements(xs),
+                    number_of_threads);
+                // The GIL is held, since position_to_sorted_position sorts
+                // the elements the first time it is called.
+                size_t const n   = result.size();
+                uint64_t *   out = result.mutable_data();
+                for (size_t i = 0; i < n; ++i) {
+                  if (out[i] != static_cast<uint64_t>(UNDEFINED)) {
+                    out[i] = S.position_to_sorted_position(out[i]);
+                  }
+                }
+                return result;
+              },
+              py::arg("xs"),
+              py::arg("number_of_threads") = 1,
+              batched_sorted_positions_doc)
+          .def(
+              "contains",
+              [](Class &S, Batch const &xs, size_t number_of_threads) {
+                Elements ys(xs);
+                auto     result = batched_positions(
+                    [&S](const_reference y) { return S.current_position(y); },
+                    ys,
+                    number_of_threads);
+                find_missing_positions(S, ys, result);
+                return batched_contains(result);
+              },
+              py::arg("xs"),
+              py::arg("number_of_threads") = 1,
+              batched_contains_doc);
+    }
+
+    // Binds the batched lookups in a FrozenFroidurePin, which never needs to
+    // be enumerated.
+    template <typename Frozen,
+              typename Elements,
+              typename Batch,
+              typename PyClass>
+    void bind_frozen_batched_lookups(PyClass &x) {
+      using const_reference = typename Frozen::const_reference;
+      x.def(
+           "positions",
+           [](Frozen const &F, Batch const &xs, size_t number_of_threads) {
+             return batched_positions_without_gil(
+                 [&F](const_reference y) { return F.position(y); },
+                 Elements(xs),
+                 number_of_threads);
+           },
+           py::arg("xs"),
+           py::arg("number_of_threads") = 1,
+           batched_positions_doc)
+          .def(
+              "contains",
+              [](Frozen const &F, Batch const &xs, size_t number_of_threads) {
+                return batched_contains(batched_positions_without_gil(
+                    [&F](const_reference y) { return F.position(y); },
+                    Elements(xs),
+                    number_of_threads));
+              },
+              py::arg("xs"),
+              py::arg("number_of_threads") = 1,
+              batched_contains_doc);
+    }
+
+    template <typename Class, typename PyClass>
+    void bind_batched_lookups(PyClass &x, std::false_type) {
+      using element_type = typename Class::element_type;
+      bind_batched_lookups<Class, ListElements<element_type>, py::list>(x);
+    }
+
+    template <typename Class, typename PyClass>
+    void bind_batched_lookups(PyClass &x, std::true_type) {
+      using element_type = typename Class::element_type;
+      bind_batched_lookups<Class, ListElements<element_type>, py::list>(x);
+      bind_batched_lookups<Class,
+                           ArrayElements<element_type>,
+                           ElementArray<element_type>>(x);
+    }
+
+    template <typename Frozen, typename PyClass>
+    void bind_frozen_batched_lookups(PyClass &x, std::false_type) {
+      using element_type = typename Frozen::element_type;
+      bind_frozen_batched_lookups<Frozen,
+                                  ListElements<element_type>,
+                                  py::list>(x);
+    }
+
+    template <typename Frozen, typename PyClass>
+    void bind_frozen_batched_lookups(PyClass &x, std::true_type) {
+      using element_type = typename Frozen::element_type;
+      bind_frozen_batched_lookups<Frozen,
+                                  ListElements<element_type>,
+                                  py::list>(x);
+      bind_frozen_batched_lookups<Frozen,
+                                  ArrayElements<element_type>,
+                                  ElementArray<element_type>>(x);
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // FrozenFroidurePin
+    ////////////////////////////////////////////////////////////////////////
+
+    template <typename T>
+    void bind_frozen_froidure_pin(py::module &m, std::string const &typestr) {
+      using Frozen             = FrozenFroidurePin<T>;
+      std::string pyclass_name = std::string("FrozenFroidurePin") + typestr;
+      py::class_<Frozen> x(m,
+                           pyclass_name.c_str(),
+                           R"pbdoc(
+        A read-only copy of the elements of a fully enumerated
+        :py:class:`FroidurePin`, returned by :py:meth:`FroidurePin.freeze`,
+        which uses much less memory, and finds the positions of elements
+        more quickly. The methods of this class do not modify it, and so
+        they can be called from any number of threads at once, and
+        :py:meth:`positions` and :py:meth:`contains` release the GIL while
+        they look up the elements.
+      )pbdoc");
+
+      x.attr("element_type") = m.attr(typestr.c_str());
+
+      x.def("size",
+            &Frozen::size,
+            R"pbdoc(
+              Returns the number of elements.
+
+              :Parameters: None
+              :return: An ``int``.
+            )pbdoc")
+          .def("__len__", &Frozen::size)
+          .def(
+              "at",
+              [](Frozen const &S, size_t i) {
+                if (i >= S.size()) {
+                  LIBSEMIGROUPS_EXCEPTION(
+                      "expected a value less than %llu, found %llu",
+                      static_cast<uint64_t>(S.size()),
+                      static_cast<uint64_t>(i));
+                }
+                return S[i];
+              },
+              py::arg("i"),
+              R"pbdoc(
+                Returns the element in position ``i``.
+
+                :param i: the position.
+                :type i: int
+
+                :return: An element.
+
+                :raises RuntimeError: if ``i`` is out of bounds.
+              )pbdoc")
+          .def(
+              "__getitem__",
+              [](Frozen const &S, size_t i) {
+                if (i >= S.size()) {
+                  throw py::index_error();
+                }
+                return S[i];
+              },
+              py::arg("i"))
+          .def("position",
+               &Frozen::position,
+               py::arg("x"),
+               R"pbdoc(
+                 Returns the position of the element ``x`` in the
+                 :py:class:`FroidurePin` that was frozen, or
+                 :py:obj:`UNDEFINED` if ``x`` is not one of its elements.
+
+                 :param x: a possible element.
+                 :type x: Element
+
+                 :return: An ``int`` or :py:obj:`UNDEFINED`.
+               )pbdoc")
+          .def("contains",
+               &Frozen::contains,
+               py::arg("x"),
+               R"pbdoc(
+                 Test membership of an element.
+
+                 :param x: a possible element.
+                 :type x: Element
+
+                 :return: A ``bool``.
+               )pbdoc")
+          .def("__contains__", &Frozen::contains)
+          .def(
+              "__iter__",
+              [](Frozen const &S) {
+                return py::make_iterator(S.cbegin(), S.cend());
+              },
+              py::keep_alive<0, 1>())
+          .def("__repr__", [pyclass_name](Frozen const &S) {
+            return std::string("<") + pyclass_name + " with "
+                   + detail::to_string(S.size()) + " elements>";
+          });
+
+      bind_frozen_batched_lookups<Frozen>(x, HasElementArray<T>());
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // FroidurePin
+    ////////////////////////////////////////////////////////////////////////
+
     template <typename T, typename S = FroidurePinTraits<T>>
     void bind_froidure_pin(py::module &m, std::string typestr) {
       using Class              = FroidurePin<T, S>;
@@ -70,6 +532,8 @@ namespace libsemigroups {
 
       x.attr("element_type") = m.attr(typestr.c_str());
 
+      bind_frozen_froidure_pin<element_type>(m, typestr);
+
       x.def(py::init<std::vector<element_type> const &>(), py::arg("coll"))
           .def(py::init<Class const &>(), py::arg("that"))
           .def("size", &Class::size)
@@ -234,7 +698,22 @@ namespace libsemigroups {
           .def("is_finite", &Class::is_finite)
           .def("equal_to", &Class::equal_to, py::arg("x"), py::arg("y"))
           .def("fast_product", &Class::fast_product, py::arg("i"), py::arg("j"))
+          .def(
+              "freeze",
+              [](Class &x) { return FrozenFroidurePin<element_type>(x); },
+              R"pbdoc(
+                Fully enumerates ``self``, and returns a read-only copy of its
+                elements, whose positions are stored in a compact hash table.
+                The copy uses much less memory than ``self``, since it does
+                not store the state of the enumeration, and its methods can be
+                called from any number of threads at once.
+
+                :Parameters: None
+                :return: A ``FrozenFroidurePin`` of the same element type.
+              )pbdoc")
           .def("__repr__", &froidure_pin_repr<Class>);
+
+      bind_batched_lookups<Class>(x, HasElementArray<element_type>());
     }
   }  // namespace
 
@@ -265,6 +744,9 @@ namespace libsemigroups {
 
     bind_froidure_pin<BMat8>(m, "BMat8");
     bind_froidure_pin<BMat<>>(m, "BMat");
+    bind_froidure_pin<PackedBMat>(m, "PackedBMat");
+    bind_froidure_pin<PackedPBR>(m, "PackedPBR");
+    bind_froidure_pin<PackedBipartition>(m, "PackedBipartition");
     bind_froidure_pin<IntMat<>>(m, "IntMat");
     bind_froidure_pin<MaxPlusMat<>>(m, "MaxPlusMat");
     bind_froidure_pin<MinPlusMat<>>(m, "MinPlusMat");
@@ -272,5 +754,26 @@ namespace libsemigroups {
     bind_froidure_pin<MaxPlusTruncMat<>>(m, "MaxPlusTruncMat");
     bind_froidure_pin<MinPlusTruncMat<>>(m, "MinPlusTruncMat");
     bind_froidure_pin<NTPMat<>>(m, "NTPMat");
+
+    bind_froidure_pin<BMat<2>>(m, "BMat2");
+    bind_froidure_pin<BMat<3>>(m, "BMat3");
+    bind_froidure_pin<BMat<4>>(m, "BMat4");
+    bind_froidure_pin<BMat<5>>(m, "BMat5");
+    bind_froidure_pin<BMat<6>>(m, "BMat6");
+    bind_froidure_pin<IntMat<2>>(m, "IntMat2");
+    bind_froidure_pin<IntMat<3>>(m, "IntMat3");
+    bind_froidure_pin<IntMat<4>>(m, "IntMat4");
+    bind_froidure_pin<IntMat<5>>(m, "IntMat5");
+    bind_froidure_pin<IntMat<6>>(m, "IntMat6");
+    bind_froidure_pin<MaxPlusMat<2>>(m, "MaxPlusMat2");
+    bind_froidure_pin<MaxPlusMat<3>>(m, "MaxPlusMat3");
+    bind_froidure_pin<MaxPlusMat<4>>(m, "MaxPlusMat4");
+    bind_froidure_pin<MaxPlusMat<5>>(m, "MaxPlusMat5");
+    bind_froidure_pin<MaxPlusMat<6>>(m, "MaxPlusMat6");
+    bind_froidure_pin<MinPlusMat<2>>(m, "MinPlusMat2");
+    bind_froidure_pin<MinPlusMat<3>>(m, "MinPlusMat3");
+    bind_froidure_pin<MinPlusMat<4>>(m, "MinPlusMat4");
+    bind_froidure_pin<MinPlusMat<5>>(m, "MinPlusMat5");
+    bind_froidure_pin<MinPlusMat<6>>(m, "MinPlusMat6");
   }
 }  // namespace libsemigroups
@@ -0,0 +1,151 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the declaration of the class template FrozenFroidurePin,
+// which is a read-only copy of the elements of a fully enumerated
+// FroidurePin, together with a compact hash table mapping every element to
+// its position.
+
+#ifndef SRC_FROZEN_FROIDURE_PIN_HPP_
+#define SRC_FROZEN_FROIDURE_PIN_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <libsemigroups/libsemigroups.hpp>
+
+namespace libsemigroups {
+
+  // The positions of the elements are stored in an open addressing hash
+  // table with linear probing and load factor at most 1/2. Every slot is a
+  // single 64-bit word containing the position of an element plus one, or 0
+  // if the slot is empty, in the low 32 bits, and a fingerprint of the hash
+  // value of the element in the high 32 bits, so that almost every lookup
+  // compares at most one element. Since none of the member functions modify
+  // the object, they can be called concurrently from any number of threads
+  // without locking.
+  template <typename T>
+  class FrozenFroidurePin {
+   public:
+    using element_type    = T;
+    using const_reference = T const&;
+    using const_iterator  = typename std::vector<T>::const_iterator;
+
+    // Fully enumerates S, and copies its elements.
+    template <typename Traits>
+    explicit FrozenFroidurePin(FroidurePin<T, Traits>& S)
+        : _elements(), _slots(), _shift(64) {
+      size_t const n = S.size();
+      if (n >= std::numeric_limits<uint32_t>::max()) {
+        LIBSEMIGROUPS_EXCEPTION("expected at most %llu elements, found %llu",
+                                static_cast<uint64_t>(
+                                    std::numeric_limits<uint32_t>::max() - 1),
+                                static_cast<uint64_t>(n));
+      }
+      _elements.reserve(n);
+      for (auto it = S.cbegin(); it != S.cend(); ++it) {
+        _elements.push_back(*it);
+      }
+
+      size_t capacity = 1;
+      while (capacity < 2 * n) {
+        capacity *= 2;
+        --_shift;
+      }
+      _slots.assign(capacity, 0);
+      for (size_t i = 0; i < n; ++i) {
+        uint64_t const h = mix(_elements[i]);
+        size_t         s = slot(h);
+        while (_slots[s] != 0) {
+          s = (s + 1) & (_slots.size() - 1);
+        }
+        _slots[s] = fingerprint(h) | (i + 1);
+      }
+    }
+
+    FrozenFroidurePin(FrozenFroidurePin const&) = default;
+    FrozenFroidurePin(FrozenFroidurePin&&)      = default;
+    FrozenFroidurePin& operator=(FrozenFroidurePin const&) = default;
+    FrozenFroidurePin& operator=(FrozenFroidurePin&&) = default;
+
+    size_t size() const noexcept {
+      return _elements.size();
+    }
+
+    const_reference operator[](size_t i) const noexcept {
+      return _elements[i];
+    }
+
+    const_iterator cbegin() const noexcept {
+      return _elements.cbegin();
+    }
+
+    const_iterator cend() const noexcept {
+      return _elements.cend();
+    }
+
+    // Returns the position of x in the FroidurePin used to construct this,
+    // or UNDEFINED if x is not one of its elements.
+    size_t position(const_reference x) const {
+      uint64_t const h = mix(x);
+      for (size_t s = slot(h);; s = (s + 1) & (_slots.size() - 1)) {
+        uint64_t const val = _slots[s];
+        if (val == 0) {
+          return static_cast<size_t>(UNDEFINED);
+        } else if ((val & ~position_mask) == fingerprint(h)) {
+          size_t const i = (val & position_mask) - 1;
+          if (EqualTo<T>()(_elements[i], x)) {
+            return i;
+          }
+        }
+      }
+    }
+
+    bool contains(const_reference x) const {
+      return position(x) != static_cast<size_t>(UNDEFINED);
+    }
+
+   private:
+    static constexpr uint64_t position_mask = 0xffffffff;
+
+    // The hash values of some elements, such as BMat8, are the elements
+    // themselves, and so they are multiplied by a large odd number. The high
+    // bits of the product choose the slot, and the low bits are the
+    // fingerprint, so that the elements in neighbouring slots rarely have
+    // equal fingerprints.
+    static uint64_t mix(const_reference x) {
+      return static_cast<uint64_t>(Hash<T>()(x)) * 0x9e3779b97f4a7c15;
+    }
+
+    static uint64_t fingerprint(uint64_t h) noexcept {
+      return h << 32;
+    }
+
+    size_t slot(uint64_t h) const noexcept {
+      return _shift == 64 ? 0 : h >> _shift;
+    }
+
+    std::vector<T>        _elements;
+    std::vector<uint64_t> _slots;
+    size_t                _shift;
+  };
+}  // namespace libsemigroups
+
+#endif  // SRC_FROZEN_FROIDURE_PIN_HPP_
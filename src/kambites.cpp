@@ -0,0 +1,454 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <pybind11/chrono.h>
+#include <pybind11/functional.h>
+#include <pybind11/operators.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <libsemigroups/libsemigroups.hpp>
+
+#include "doc-strings.hpp"
+#include "main.hpp"
+
+namespace py = pybind11;
+
+namespace libsemigroups {
+  using rule_type = FpSemigroupInterface::rule_type;
+
+  void init_kambites(py::module &m) {
+    using Kambites_ = fpsemigroup::Kambites<>;
+
+    py::class_<Kambites_, std::shared_ptr<Kambites_>>(m,
+                                                      "Kambites",
+                                                      R"pbdoc(
+      This class implements Kambites' algorithm for solving the word problem
+      in small overlap monoids, i.e. those satisfying the condition
+      :math:`C(4)`. For such monoids, :py:meth:`equal_to` and
+      :py:meth:`normal_form` run in time linear in the length of their
+      arguments, whereas :py:class:`KnuthBendix` and :py:class:`ToddCoxeter`
+      typically fail to terminate, since such monoids are infinite.
+    )pbdoc")
+        .def(py::init<>(),
+             R"pbdoc(
+               Default constructor.
+             )pbdoc")
+        .def("set_alphabet",
+             py::overload_cast<std::string const &>(&Kambites_::set_alphabet),
+             py::arg("a"),
+             R"pbdoc(
+               Set the alphabet of the finitely presented semigroup.
+
+               :Parameters: **a** (str) - the alphabet.
+
+               :Returns: None
+             )pbdoc")
+        .def("set_alphabet",
+             py::overload_cast<size_t>(&Kambites_::set_alphabet),
+             py::arg("n"),
+             R"pbdoc(
+               Set the size of the alphabet.
+
+               :Parameters: **n** (int) - the number of letters.
+
+               :Returns: None
+             )pbdoc")
+        .def("alphabet",
+             py::overload_cast<>(&Kambites_::alphabet, py::const_),
+             R"pbdoc(
+               Returns the alphabet.
+
+               :Parameters: None
+               :Returns: A string.
+             )pbdoc")
+        .def("alphabet",
+             py::overload_cast<size_t>(&Kambites_::alphabet, py::const_),
+             py::arg("i"),
+             R"pbdoc(
+               Returns the i-th letter of the alphabet.
+
+               :Parameters: **i** (int) - the index of the letter.
+
+               :Returns: A string.
+             )pbdoc")
+        .def("set_identity",
+             py::overload_cast<letter_type>(&Kambites_::set_identity),
+             py::arg("id"),
+             R"pbdoc(
+               Set a string of length 1 belonging to :py:meth:`alphabet` to be
+               the identity using its index.
+
+               :Parameters: **id** (int) - the index of the character to be
+                            the identity.
+
+               :Returns: None
+             )pbdoc")
+        .def("set_identity",
+             py::overload_cast<std::string const &>(&Kambites_::set_identity),
+             py::arg("id"),
+             R"pbdoc(
+               Set a string of length 1 belonging to :py:meth:`alphabet` to be
+               the identity.
+
+               :Parameters: **id** (str) - a string containing the character
+                            to be the identity.
+
+               :Returns: None
+             )pbdoc")
+        .def("identity",
+             &Kambites_::identity,
+             R"pbdoc(
+               Returns the identity, or raises an exception if there isn't one.
+
+               :Parameters: None
+               :return: A string.
+             )pbdoc")
+        .def("set_inverses",
+             &Kambites_::set_inverses,
+             py::arg("a"),
+             R"pbdoc(
+               Set the inverses of letters in :py:meth:`alphabet`.
+
+               :param a: a string of length ``len(alphabet())``.
+               :type a: str
+
+               :return: None
+             )pbdoc")
+        .def("inverses",
+             &Kambites_::inverses,
+             R"pbdoc(
+               Returns the inverses, or raises an exception if there aren't
+               any.
+
+               :Parameters: None
+               :return: A string.
+             )pbdoc")
+        .def("add_rule",
+             py::overload_cast<std::string const &, std::string const &>(
+                 &Kambites_::add_rule),
+             py::arg("u"),
+             py::arg("v"),
+             R"pbdoc(
+               Add a rule.
+
+               :Parameters: - **u** (str) - the left-hand side of the rule
+                              being added.
+                            - **v** (str) - the right-hand side of the rule
+                              being added.
+
+               :Returns: None
+             )pbdoc")
+        .def("add_rule",
+             py::overload_cast<word_type const &, word_type const &>(
+                 &Kambites_::add_rule),
+             py::arg("u"),
+             py::arg("v"),
+             R"pbdoc(
+               Add a rule.
+
+               :Parameters: - **u** (List[int]) - the left-hand side of the
+                              rule being added.
+                            - **v** (List[int]) - the right-hand side of the
+                              rule being added.
+
+               :Returns: None
+             )pbdoc")
+        .def("add_rule",
+             py::overload_cast<rule_type>(&Kambites_::add_rule),
+             py::arg("rel"),
+             R"pbdoc(
+               Add a rule.
+
+               :Parameters: **rel** (Tuple[str, str]) - the rule being added.
+
+               :Returns: None
+             )pbdoc")
+        .def("add_rules",
+             py::overload_cast<std::vector<rule_type> const &>(
+                 &Kambites_::add_rules),
+             py::arg("rels"),
+             R"pbdoc(
+               Add the rules in a list.
+
+               :Parameters: **rels** (List[Tuple[str, str]]) - list of rules to
+                            add.
+
+               :Returns: None
+             )pbdoc")
+        .def(
+            "number_of_rules",
+            [](Kambites_ const &k) { return k.number_of_rules(); },
+            R"pbdoc(
+              Returns the number of rules.
+
+              :Parameters: None
+              :return: An ``int``.
+            )pbdoc")
+        .def(
+            "rules",
+            [](Kambites_ const &k) {
+              return py::make_iterator(k.cbegin_rules(), k.cend_rules());
+            },
+            R"pbdoc(
+              Returns an iterator to the rules.
+
+              :Parameters: None
+              :return: An iterator.
+            )pbdoc")
+        .def("small_overlap_class",
+             &Kambites_::small_overlap_class,
+             R"pbdoc(
+               Returns the small overlap class of the presentation, i.e. the
+               greatest positive integer :math:`n` such that no relation word
+               can be written as the product of fewer than :math:`n` pieces.
+               A *piece* is a word occurring as a factor of at least two
+               relation words, or twice in the same relation word.
+
+               :Parameters: None
+               :return: An ``int`` or :py:obj:`POSITIVE_INFINITY`.
+             )pbdoc")
+        .def("size",
+             &Kambites_::size,
+             R"pbdoc(
+               Returns the size of the finitely presented semigroup.
+
+               :Parameters: None
+               :return: :py:obj:`POSITIVE_INFINITY`.
+
+               :raises RuntimeError:
+                 if :py:meth:`small_overlap_class` is less than ``4``.
+             )pbdoc")
+        .def("is_obviously_infinite",
+             &Kambites_::is_obviously_infinite,
+             R"pbdoc(
+               Return ``True`` if the finitely presented semigroup is obviously
+               infinite, and ``False`` if it is not obviously infinite.
+
+               :Parameters: None
+               :return: A ``bool``.
+             )pbdoc")
+        .def("equal_to",
+             py::overload_cast<std::string const &, std::string const &>(
+                 &Kambites_::equal_to),
+             py::arg("u"),
+             py::arg("v"),
+             R"pbdoc(
+               Check if two words represent the same element. This function
+               runs in time linear in the total length of ``u`` and ``v``.
+
+               :Parameters: - **u** (str) - the first word.
+                            - **v** (str) - the second word.
+
+               :Returns: A ``bool``.
+
+               :raises RuntimeError:
+                 if :py:meth:`small_overlap_class` is less than ``4``.
+             )pbdoc")
+        .def("equal_to",
+             py::overload_cast<word_type const &, word_type const &>(
+                 &Kambites_::equal_to),
+             py::arg("u"),
+             py::arg("v"),
+             R"pbdoc(
+               Check if two words represent the same element. This function
+               runs in time linear in the total length of ``u`` and ``v``.
+
+               :Parameters: - **u** (List[int]) - the first word.
+                            - **v** (List[int]) - the second word.
+
+               :Returns: A ``bool``.
+
+               :raises RuntimeError:
+                 if :py:meth:`small_overlap_class` is less than ``4``.
+             )pbdoc")
+        .def("normal_form",
+             py::overload_cast<std::string const &>(&Kambites_::normal_form),
+             py::arg("w"),
+             R"pbdoc(
+               Returns the lexicographically least word representing the
+               same element as ``w``. This is not necessarily the short-lex
+               least such word, for example, if the only rule is ``abcd =
+               efg``, then the normal form of ``efg`` is ``abcd``.
+
+               :Parameters: **w** (str) - the word.
+
+               :Returns: A string.
+
+               :raises RuntimeError:
+                 if :py:meth:`small_overlap_class` is less than ``4``.
+             )pbdoc")
+        .def("normal_form",
+             py::overload_cast<word_type const &>(&Kambites_::normal_form),
+             py::arg("w"),
+             R"pbdoc(
+               Returns the lexicographically least word representing the
+               same element as ``w``. This is not necessarily the short-lex
+               least such word, for example, if the only rule is ``abcd =
+               efg``, then the normal form of ``efg`` is ``abcd``.
+
+               :Parameters: **w** (List[int]) - the word.
+
+               :Returns: A list of integers.
+
+               :raises RuntimeError:
+                 if :py:meth:`small_overlap_class` is less than ``4``.
+             )pbdoc")
+        .def("validate_letter",
+             py::overload_cast<char>(&Kambites_::validate_letter, py::const_),
+             py::arg("c"),
+             R"pbdoc(
+               Validates a letter.
+
+               :Parameters: **c** (str) - the letter to validate.
+
+               :Returns: None
+             )pbdoc")
+        .def("validate_letter",
+             py::overload_cast<letter_type>(&Kambites_::validate_letter,
+                                            py::const_),
+             py::arg("c"),
+             R"pbdoc(
+               Validates a letter.
+
+               :Parameters: **c** (int) - the letter to validate.
+
+               :Returns: None
+             )pbdoc")
+        .def("validate_word",
+             py::overload_cast<std::string const &>(&Kambites_::validate_word,
+                                                    py::const_),
+             py::arg("w"),
+             R"pbdoc(
+               Validates a word.
+
+               :Parameters: **w** (str) - the word to validate.
+
+               :Returns: None
+             )pbdoc")
+        .def("validate_word",
+             py::overload_cast<word_type const &>(&Kambites_::validate_word,
+                                                  py::const_),
+             py::arg("w"),
+             R"pbdoc(
+               Validates a word.
+
+               :Parameters: **w** (List[int]) - the word to validate.
+
+               :Returns: None
+             )pbdoc")
+        .def("char_to_uint",
+             &Kambites_::char_to_uint,
+             py::arg("a"),
+             R"pbdoc(
+               Convert a single letter ``string`` to a ``int`` representing the
+               same generator.
+
+               :param a: the string to convert.
+               :type a: str
+
+               :return: an ``int``.
+             )pbdoc")
+        .def("uint_to_char",
+             &Kambites_::uint_to_char,
+             py::arg("a"),
+             R"pbdoc(
+               Convert an ``int`` to a ``char`` representing the same
+               generator.
+
+               :param a: the letter to convert.
+               :type a: int
+
+               :return: A ``str``.
+             )pbdoc")
+        .def("string_to_word",
+             &Kambites_::string_to_word,
+             py::arg("w"),
+             R"pbdoc(
+               Convert a string to a list of ``int`` representing the same
+               element.
+
+               :param w: the string to convert.
+               :type w: str
+
+               :return: a ``List[int]``.
+             )pbdoc")
+        .def("word_to_string",
+             &Kambites_::word_to_string,
+             py::arg("w"),
+             R"pbdoc(
+               Convert a list of ``int`` to a string representing the same
+               element.
+
+               :param w: the list to convert.
+               :type w: List[int]
+
+               :return: A string.
+             )pbdoc")
+        .def("to_gap_string",
+             &Kambites_::to_gap_string,
+             R"pbdoc(
+               Returns a string containing GAP commands for defining a finitely
+               presented semigroup equal to that represented by this.
+
+               :Parameters: None
+               :return: A string.
+             )pbdoc")
+        .def("run_for",
+             (void(Kambites_::  // NOLINT(whitespace/parens)
+                       *)(std::chrono::nanoseconds))
+                 & Runner::run_for,
+             py::arg("t"),
+             runner_doc_strings::run_for)
+        .def("run_until",
+             (void(Kambites_::  // NOLINT(whitespace/parens)
+                       *)(std::function<bool()> &))
+                 & Runner::run_until,
+             py::arg("func"),
+             runner_doc_strings::run_until)
+        .def("run", &Kambites_::run, runner_doc_strings::run)
+        .def("kill", &Kambites_::kill, runner_doc_strings::kill)
+        .def("dead", &Kambites_::dead, runner_doc_strings::dead)
+        .def("finished", &Kambites_::finished, runner_doc_strings::finished)
+        .def("started", &Kambites_::started, runner_doc_strings::started)
+        .def(
+            "running",
+            [](Kambites_ const &k) { return k.running(); },
+            runner_doc_strings::running)
+        .def("timed_out", &Kambites_::timed_out, runner_doc_strings::timed_out)
+        .def("stopped", &Kambites_::stopped, runner_doc_strings::stopped)
+        .def("stopped_by_predicate",
+             &Kambites_::stopped_by_predicate,
+             runner_doc_strings::stopped_by_predicate)
+        .def("report", &Kambites_::report, runner_doc_strings::report)
+        .def("report_every",
+             (void(Kambites_::  // NOLINT(whitespace/parens)
+                       *)(std::chrono::nanoseconds))
+                 & Runner::report_every,
+             py::arg("t"),
+             runner_doc_strings::report_every)
+        .def("report_why_we_stopped",
+             &Kambites_::report_why_we_stopped,
+             runner_doc_strings::report_why_we_stopped)
+        .def("__repr__", [](Kambites_ const &k) {
+          return std::string("<Kambites with ")
+                 + detail::to_string(k.alphabet().size()) + " letters and "
+                 + detail::to_string(k.number_of_rules()) + " rules>";
+        });
+  }
+}  // namespace libsemigroups
@@ -102,15 +102,24 @@ namespace libsemigroups {
     init_bipart(m);
     init_bmat8(m);
     init_cong(m);
+    init_kambites(m);
     init_fpsemi(m);
     init_knuth_bendix(m);
     init_matrix(m);
+    init_packed_bipart(m);
+    init_packed_bmat(m);
+    init_packed_pbr(m);
     init_pbr(m);
+    init_present(m);
+    init_sims1(m);
     init_todd_coxeter(m);
     init_transf(m);
     init_words(m);
 
     init_froidure_pin(m);
+    init_element_array(m);
+    init_element_set(m);
+    init_action(m);
 
 #ifdef VERSION_INFO
     m.attr("__version__") = VERSION_INFO;
@@ -28,16 +28,25 @@
 namespace libsemigroups {
   namespace py = pybind11;
 
+  void init_action(py::module&);
   void init_action_digraph(py::module&);
   void init_bipart(py::module&);
   void init_bmat8(py::module&);
   void init_cong(py::module&);
+  void init_element_array(py::module&);
+  void init_element_set(py::module&);
   void init_forest(py::module&);
   void init_fpsemi(py::module&);
   void init_froidure_pin(py::module&);
+  void init_kambites(py::module&);
   void init_knuth_bendix(py::module&);
   void init_matrix(py::module&);
+  void init_packed_bipart(py::module&);
+  void init_packed_bmat(py::module&);
+  void init_packed_pbr(py::module&);
   void init_pbr(py::module&);
+  void init_present(py::module&);
+  void init_sims1(py::module&);
   void init_todd_coxeter(py::module&);
   void init_transf(py::module&);
   void init_words(py::module&);
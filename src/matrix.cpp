@@ -16,8 +16,19 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <pybind11/chrono.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -25,11 +36,7 @@
 #include <libsemigroups/libsemigroups.hpp>
 
 #include "main.hpp"
-
-// TODO(later):
-// 1) RowViews
-// 2) make/constructors from Row (so that the output of, e.g. rows, can be used
-//    as input.
+#include "parallel.hpp"
 
 namespace py = pybind11;
 namespace libsemigroups {
@@ -44,42 +51,755 @@ namespace libsemigroups {
         return result;
       }
 
+      // The semirings of runtime matrices must outlive the matrices, and
+      // so are interned in a SemiringCache, and never destroyed. The cache
+      // is an append-only singly linked list, so that lookups never lock,
+      // and the same semiring is returned for the same key even when
+      // several threads (which may not hold the GIL) try to insert it at
+      // once. There are only ever a handful of distinct thresholds and
+      // periods in use, so a list is fast enough.
+      template <typename Key, typename T>
+      class SemiringCache {
+        struct Node {
+          Key                      key;
+          std::unique_ptr<T const> value;
+          Node *                   next;
+        };
+
+       public:
+        SemiringCache() : _head(nullptr) {}
+
+        SemiringCache(SemiringCache const &) = delete;
+        SemiringCache &operator=(SemiringCache const &) = delete;
+
+        ~SemiringCache() {
+          Node *node = _head.load();
+          while (node != nullptr) {
+            Node *next = node->next;
+            delete node;
+            node = next;
+          }
+        }
+
+        // Returns the semiring with key <key>, constructing it from <args>
+        // if there is no such semiring.
+        template <typename... Args>
+        T const *get(Key const &key, Args &&...args) {
+          Node *   head   = _head.load(std::memory_order_acquire);
+          T const *result = find(head, nullptr, key);
+          if (result != nullptr) {
+            return result;
+          }
+          Node *node = new Node{
+              key,
+              std::make_unique<T const>(std::forward<Args>(args)...),
+              head};
+          // If the compare-exchange fails, then node->next is set to the
+          // current head, and we only have to check the nodes inserted since
+          // <head> for <key>.
+          while (!_head.compare_exchange_weak(node->next,
+                                              node,
+                                              std::memory_order_release,
+                                              std::memory_order_acquire)) {
+            result = find(node->next, head, key);
+            if (result != nullptr) {
+              delete node;
+              return result;
+            }
+            head = node->next;
+          }
+          return node->value.get();
+        }
+
+       private:
+        static T const *find(Node *first, Node *last, Key const &key) {
+          for (; first != last; first = first->next) {
+            if (first->key == key) {
+              return first->value.get();
+            }
+          }
+          return nullptr;
+        }
+
+        std::atomic<Node *> _head;
+      };
+
       template <typename T>
       T const *semiring(size_t threshold) {
-        static std::unordered_map<size_t, std::unique_ptr<T const>> cache;
-        auto it = cache.find(threshold);
-        if (it == cache.end()) {
-          it = cache.emplace(threshold, std::make_unique<T const>(threshold))
-                   .first;
-        }
-        return it->second.get();
+        static SemiringCache<size_t, T> cache;
+        return cache.get(threshold, threshold);
       }
 
       template <typename T>
       T const *semiring(size_t threshold, size_t period) {
-        static std::unordered_map<std::pair<size_t, size_t>,
-                                  std::unique_ptr<T const>,
-                                  Hash<std::pair<size_t, size_t>>>
-             cache;
-        auto tp = std::make_pair(threshold, period);
-        auto it = cache.find(tp);
-        if (it == cache.end()) {
-          it = cache.emplace(tp, std::make_unique<T const>(threshold, period))
-                   .first;
+        static SemiringCache<std::pair<size_t, size_t>, T> cache;
+        return cache.get(std::make_pair(threshold, period), threshold, period);
+      }
+
+      template <typename T>
+      using numpy_array_type
+          = py::array_t<typename T::scalar_type,
+                        py::array::c_style | py::array::forcecast>;
+
+      // Returns true if the value <v> is representable by the integer type S.
+      template <typename S>
+      bool is_representable(int64_t v) {
+        if (std::is_signed<S>::value) {
+          return v >= static_cast<int64_t>(std::numeric_limits<S>::min())
+                 && v <= static_cast<int64_t>(std::numeric_limits<S>::max());
+        }
+        return v >= 0
+               && static_cast<uint64_t>(v)
+                      <= static_cast<uint64_t>(std::numeric_limits<S>::max());
+      }
+
+      template <typename S>
+      bool is_representable(uint64_t v) {
+        return v <= static_cast<uint64_t>(std::numeric_limits<S>::max());
+      }
+
+      template <typename S>
+      bool is_representable(double v) {
+        // 2 ^ digits is one more than the maximum value of S, and is exactly
+        // representable as a double, unlike the maximum value itself.
+        double const bound = std::ldexp(1.0, std::numeric_limits<S>::digits);
+        return std::trunc(v) == v && v < bound
+               && v >= (std::is_signed<S>::value ? -bound : 0.0);
+      }
+
+      // Throws if some entry of <a>, converted to the type V, is not
+      // representable by the type S.
+      template <typename S, typename V>
+      void validate_entries(py::array const &a) {
+        auto b = py::array_t<V, py::array::c_style | py::array::forcecast>::
+            ensure(a);
+        if (!b) {
+          throw py::error_already_set();
+        }
+        for (V const *it = b.data(); it != b.data() + b.size(); ++it) {
+          if (!is_representable<S>(*it)) {
+            LIBSEMIGROUPS_EXCEPTION(
+                "expected integer entries in the range [%s, %s], found %s",
+                std::to_string(std::numeric_limits<S>::min()).c_str(),
+                std::to_string(std::numeric_limits<S>::max()).c_str(),
+                std::to_string(*it).c_str());
+          }
         }
-        return it->second.get();
       }
 
+      // Returns a C-contiguous 2-dimensional array with the scalar type of T
+      // with the same entries as <a>, copying only if necessary. The entries
+      // of <a> are checked first, since forcecast silently truncates
+      // floating point numbers, and wraps integers out of range.
       template <typename T>
-      auto bind_matrix_common(py::module &m, char const *type_name) {
+      numpy_array_type<T> to_numpy_array_type(py::array const &a) {
+        using scalar_type = typename T::scalar_type;
+        switch (a.dtype().attr("kind").cast<std::string>()[0]) {
+          case 'b':
+            break;
+          case 'i':
+            validate_entries<scalar_type, int64_t>(a);
+            break;
+          case 'u':
+            validate_entries<scalar_type, uint64_t>(a);
+            break;
+          case 'f':
+            validate_entries<scalar_type, double>(a);
+            break;
+          default:
+            throw py::type_error(
+                string_format("expected an array of integers, found an array "
+                              "of dtype %s",
+                              py::str(a.dtype()).cast<std::string>().c_str()));
+        }
+        auto result = numpy_array_type<T>::ensure(a);
+        if (!result) {
+          throw py::error_already_set();
+        } else if (result.ndim() != 2) {
+          LIBSEMIGROUPS_EXCEPTION(
+              "expected a 2-dimensional array, found %llu dimension(s)",
+              static_cast<uint64_t>(result.ndim()));
+        }
+        return result;
+      }
+
+      // Copies the entries of the array <a>, which must have the same shape
+      // as <x>, into the storage of <x>.
+      template <typename T>
+      void copy_from_numpy(T &x, numpy_array_type<T> const &a) {
+        std::copy(a.data(), a.data() + a.size(), x.begin());
+      }
+
+      template <typename T>
+      numpy_array_type<T> copy_to_numpy(T const &x) {
+        numpy_array_type<T> result({x.number_of_rows(), x.number_of_cols()});
+        std::copy(x.cbegin(), x.cend(), result.mutable_data());
+        return result;
+      }
+
+      // numpy.asarray and numpy.array call the __array__ method, with the
+      // keyword arguments dtype and (since NumPy 2.0) copy, of objects that
+      // do not support the buffer protocol. The array <a> is always a copy.
+      py::object copied_array(py::array         a,
+                              py::object const &dtype,
+                              py::object const &copy) {
+        if (!copy.is_none() && !copy.cast<bool>()) {
+          throw py::value_error("the entries cannot be exported without "
+                                "copying them, since the matrix is dynamic");
+        }
+        if (!dtype.is_none()) {
+          return a.attr("astype")(dtype);
+        }
+        return std::move(a);
+      }
+
+      // Returns pointers to the matrices in <xs>, so that they can be used
+      // without the GIL, and without copying them. Every matrix must be
+      // square and of dimension <n>, where <n> is the dimension of the first
+      // matrix if <n> is UNDEFINED.
+      template <typename T>
+      std::vector<T const *> matrix_pointers(py::list const &xs, size_t &n) {
+        std::vector<T const *> result;
+        result.reserve(xs.size());
+        for (auto const &x : xs) {
+          T const &y = x.cast<T const &>();
+          if (n == UNDEFINED) {
+            n = y.number_of_rows();
+          }
+          if (y.number_of_rows() != n || y.number_of_cols() != n) {
+            LIBSEMIGROUPS_EXCEPTION(
+                "expected square matrices of dimension %llu, found %llux%llu",
+                static_cast<uint64_t>(n),
+                static_cast<uint64_t>(y.number_of_rows()),
+                static_cast<uint64_t>(y.number_of_cols()));
+          }
+          result.push_back(&y);
+        }
+        return result;
+      }
+
+      template <typename T>
+      std::vector<T> products(py::list const &xs,
+                              py::list const &ys,
+                              size_t          number_of_threads) {
+        if (xs.size() != ys.size()) {
+          LIBSEMIGROUPS_EXCEPTION(
+              "expected lists of equal length, found %llu and %llu",
+              static_cast<uint64_t>(xs.size()),
+              static_cast<uint64_t>(ys.size()));
+        }
+        size_t n  = UNDEFINED;
+        auto   xp = matrix_pointers<T>(xs, n);
+        auto   yp = matrix_pointers<T>(ys, n);
+        // Copying the matrices allocates the results with the correct
+        // dimensions and semiring.
+        std::vector<T> result;
+        result.reserve(xp.size());
+        for (auto x : xp) {
+          result.push_back(*x);
+        }
+        py::gil_scoped_release release;
+        parallel_for(result.size(),
+                     number_of_threads,
+                     [&result, &xp, &yp](size_t first, size_t last) {
+                       for (size_t i = first; i < last; ++i) {
+                         result[i].product_inplace(*xp[i], *yp[i]);
+                       }
+                     });
+        return result;
+      }
+
+      template <typename T>
+      T product(py::list const &xs, size_t number_of_threads) {
+        if (xs.size() == 0) {
+          LIBSEMIGROUPS_EXCEPTION("expected a non-empty list of matrices");
+        }
+        size_t n  = UNDEFINED;
+        auto   xp = matrix_pointers<T>(xs, n);
+
+        py::gil_scoped_release release;
+        // Since the product is associative, every thread computes the product
+        // of a consecutive range of the matrices, and these are multiplied
+        // together in order at the end.
+        number_of_threads = std::max(size_t(1),
+                                     std::min(number_of_threads, xp.size()));
+        std::vector<T> partial(number_of_threads, *xp[0]);
+        size_t const   q = xp.size() / number_of_threads;
+        size_t const   r = xp.size() % number_of_threads;
+        parallel_for(number_of_threads,
+                     number_of_threads,
+                     [&partial, &xp, q, r](size_t first, size_t last) {
+                       for (size_t i = first; i < last; ++i) {
+                         size_t start = i * q + std::min(i, r);
+                         size_t stop  = start + q + (i < r ? 1 : 0);
+                         T      tmp(*xp[start]);
+                         partial[i] = *xp[start];
+                         for (size_t j = start + 1; j < stop; ++j) {
+                           tmp.product_inplace(partial[i], *xp[j]);
+                           partial[i].swap(tmp);
+                         }
+                       }
+                     });
+        T tmp(partial[0]);
+        for (size_t i = 1; i < partial.size(); ++i) {
+          tmp.product_inplace(partial[0], partial[i]);
+          partial[0].swap(tmp);
+        }
+        return partial[0];
+      }
+
+      // The dimensions of a matrix whose dimensions are template parameters
+      // are only asserted by libsemigroups, and so are checked here before
+      // constructing such a matrix.
+      template <typename T>
+      struct StaticDimensions {
+        static void validate(size_t, size_t) {}
+      };
+
+      template <typename PlusOp,
+                typename ProdOp,
+                typename ZeroOp,
+                typename OneOp,
+                size_t R,
+                size_t C,
+                typename Scalar>
+      struct StaticDimensions<
+          StaticMatrix<PlusOp, ProdOp, ZeroOp, OneOp, R, C, Scalar>> {
+        static void validate(size_t r, size_t c) {
+          if (r != R || c != C) {
+            LIBSEMIGROUPS_EXCEPTION(
+                "expected a %llux%llu matrix, found %llux%llu",
+                static_cast<uint64_t>(R),
+                static_cast<uint64_t>(C),
+                static_cast<uint64_t>(r),
+                static_cast<uint64_t>(c));
+          }
+        }
+      };
+
+      // The entries of a matrix whose dimensions are template parameters are
+      // stored in the matrix object itself, whereas those of every other
+      // matrix are stored in a std::vector, which swap exchanges with that of
+      // another matrix.
+      template <typename T>
+      struct IsStaticMatrix : std::false_type {};
+
+      template <typename PlusOp,
+                typename ProdOp,
+                typename ZeroOp,
+                typename OneOp,
+                size_t R,
+                size_t C,
+                typename Scalar>
+      struct IsStaticMatrix<
+          StaticMatrix<PlusOp, ProdOp, ZeroOp, OneOp, R, C, Scalar>>
+          : std::true_type {};
+
+      template <typename T>
+      void validate_dimensions(
+          std::vector<std::vector<typename T::scalar_type>> const &rows) {
+        if (rows.empty()) {
+          StaticDimensions<T>::validate(0, 0);
+        }
+        for (auto const &row : rows) {
+          StaticDimensions<T>::validate(rows.size(), row.size());
+        }
+      }
+
+      // Matrices over semirings with finitely many elements, for which the
+      // powers of every matrix are eventually periodic.
+      template <typename T>
+      struct IsOverFiniteSemiring : std::false_type {};
+
+      template <>
+      struct IsOverFiniteSemiring<BMat<>> : std::true_type {};
+
+      template <>
+      struct IsOverFiniteSemiring<BMat<2>> : std::true_type {};
+
+      template <>
+      struct IsOverFiniteSemiring<BMat<3>> : std::true_type {};
+
+      template <>
+      struct IsOverFiniteSemiring<BMat<4>> : std::true_type {};
+
+      template <>
+      struct IsOverFiniteSemiring<BMat<5>> : std::true_type {};
+
+      template <>
+      struct IsOverFiniteSemiring<BMat<6>> : std::true_type {};
+
+      template <>
+      struct IsOverFiniteSemiring<MaxPlusTruncMat<>> : std::true_type {};
+
+      template <>
+      struct IsOverFiniteSemiring<MinPlusTruncMat<>> : std::true_type {};
+
+      template <>
+      struct IsOverFiniteSemiring<NTPMat<>> : std::true_type {};
+
+      template <typename T>
+      void validate_square(T const &x) {
+        if (x.number_of_rows() != x.number_of_cols()) {
+          LIBSEMIGROUPS_EXCEPTION("expected a square matrix, found %llux%llu",
+                                  static_cast<uint64_t>(x.number_of_rows()),
+                                  static_cast<uint64_t>(x.number_of_cols()));
+        }
+      }
+
+      // Returns x ^ k using repeated squaring, so that only O(log k) products
+      // are computed, each into one of two preallocated matrices.
+      template <typename T>
+      T matrix_pow(T const &x, uint64_t k) {
+        validate_square(x);
+        if (k == 0) {
+          return x.one();
+        }
+        T base(x), result(x), tmp(x);
+        bool first = true;
+        while (true) {
+          if (k & 1) {
+            if (first) {
+              result = base;
+              first  = false;
+            } else {
+              tmp.product_inplace(result, base);
+              result.swap(tmp);
+            }
+          }
+          k >>= 1;
+          if (k == 0) {
+            return result;
+          }
+          tmp.product_inplace(base, base);
+          base.swap(tmp);
+        }
+      }
+
+      // Returns the least (index, period) such that x ^ (index + period) =
+      // x ^ index, by computing, and storing, every power of x until one is
+      // repeated.
+      template <typename T>
+      std::pair<uint64_t, uint64_t> matrix_index_and_period(T const &x) {
+        validate_square(x);
+        struct MatrixHash {
+          size_t operator()(T const &y) const {
+            return y.hash_value();
+          }
+        };
+        std::unordered_map<T, uint64_t, MatrixHash> seen;
+        T                                           power(x), tmp(x);
+        for (uint64_t i = 1;; ++i) {
+          auto it = seen.emplace(power, i);
+          if (!it.second) {
+            return std::make_pair(it.first->second, i - it.first->second);
+          }
+          tmp.product_inplace(power, x);
+          power.swap(tmp);
+        }
+      }
+
+      // Returns true if <k> is a valid exponent that fits into a uint64_t,
+      // and false if it is too large.
+      bool validate_exponent(py::int_ const &k) {
+        if (k < py::int_(0)) {
+          LIBSEMIGROUPS_EXCEPTION("expected a non-negative exponent");
+        }
+        return k <= py::int_(std::numeric_limits<uint64_t>::max());
+      }
+
+      template <typename T>
+      void bind_matrix_pow(py::class_<T> &x, std::false_type) {
+        x.def(
+            "__pow__",
+            [](T const &y, py::int_ k) {
+              if (!validate_exponent(k)) {
+                LIBSEMIGROUPS_EXCEPTION("the exponent is too large");
+              }
+              uint64_t kk = k.cast<uint64_t>();
+              py::gil_scoped_release release;
+              return matrix_pow(y, kk);
+            },
+            py::is_operator());
+      }
+
+      // The exponent of a matrix over a finite semiring can be arbitrarily
+      // large, since it can be reduced using the index and period.
+      template <typename T>
+      void bind_matrix_pow(py::class_<T> &x, std::true_type) {
+        x.def(
+             "__pow__",
+             [](T const &y, py::int_ k) {
+               if (validate_exponent(k)) {
+                 uint64_t kk = k.cast<uint64_t>();
+                 py::gil_scoped_release release;
+                 return matrix_pow(y, kk);
+               }
+               std::pair<uint64_t, uint64_t> ip;
+               {
+                 py::gil_scoped_release release;
+                 ip = matrix_index_and_period(y);
+               }
+               uint64_t const i = ip.first, p = ip.second;
+               // Since k > i, x ^ k = x ^ (i + ((k - i) mod p)).
+               uint64_t km = k.attr("__mod__")(p).cast<uint64_t>();
+               uint64_t kk = i + (km + p - (i % p)) % p;
+               py::gil_scoped_release release;
+               return matrix_pow(y, kk);
+             },
+             py::is_operator())
+            .def(
+                "index_and_period",
+                [](T const &y) {
+                  py::gil_scoped_release release;
+                  return matrix_index_and_period(y);
+                },
+                R"pbdoc(
+                  Returns the least ``(index, period)`` such that
+                  ``x ** (index + period) == x ** index``.
+
+                  The powers of ``x`` are computed and stored until one is
+                  repeated, and so this requires ``index + period`` products,
+                  and space for ``index + period`` matrices.
+
+                  :Parameters: None
+                  :return: A ``Tuple[int, int]``.
+
+                  :raises RuntimeError: if the matrix is not square.
+                )pbdoc");
+      }
+
+      // Returns true if the row view <rv> and the row <r> have the same
+      // entries.
+      template <typename RowView, typename Row>
+      bool row_view_equal(RowView const &rv, Row const &r) {
+        return r.number_of_rows() == 1 && rv.size() == r.number_of_cols()
+               && std::equal(rv.cbegin(), rv.cend(), r.cbegin());
+      }
+
+      // The operations on row views that return, or compare with, rows are
+      // only bound if the rows of T are T's, since otherwise the type of the
+      // rows (such as StaticMatrix<..., 1, C, ...>) is not bound.
+      template <typename T>
+      void bind_row_view_row_ops(py::class_<typename T::RowView> &x,
+                                 std::true_type) {
         using Row         = typename T::Row;
+        using RowView     = typename T::RowView;
+        using scalar_type = typename T::scalar_type;
+
+        x.def("__eq__", &row_view_equal<RowView, Row>, py::is_operator())
+            .def(
+                "__ne__",
+                [](RowView const &rv, Row const &r) {
+                  return !row_view_equal(rv, r);
+                },
+                py::is_operator())
+            .def(
+                "__add__",
+                [](RowView const &rv, RowView const &that) {
+                  if (rv.size() != that.size()) {
+                    LIBSEMIGROUPS_EXCEPTION(
+                        "expected row views of equal size, found %llu and %llu",
+                        static_cast<uint64_t>(rv.size()),
+                        static_cast<uint64_t>(that.size()));
+                  }
+                  return Row(rv) + Row(that);
+                },
+                py::is_operator())
+            .def(
+                "__mul__",
+                [](RowView const &rv, scalar_type a) {
+                  Row result(rv);
+                  result *= a;
+                  return result;
+                },
+                py::is_operator())
+            .def("__repr__", [](RowView const &rv) {
+              return py::repr(py::cast(Row(rv))).cast<std::string>();
+            });
+      }
+
+      template <typename T>
+      void bind_row_view_row_ops(py::class_<typename T::RowView> &x,
+                                 std::false_type) {
+        using RowView = typename T::RowView;
+        x.def("__repr__", [](RowView const &rv) {
+          return py::repr(py::cast(std::vector<typename T::scalar_type>(
+                              rv.cbegin(), rv.cend())))
+              .cast<std::string>();
+        });
+      }
+
+      constexpr char const *row_view_doc = R"pbdoc(
+          A view of a row of a matrix, that does not copy the entries of the
+          row. A row view is only valid for as long as the matrix it was
+          obtained from is not modified, for example, by :py:meth:`swap`.
+        )pbdoc";
+
+      // The row views of static matrices support the buffer protocol, see
+      // matrix_class.
+      template <typename T>
+      py::class_<typename T::RowView>
+      row_view_class(py::module &m, char const *name, std::true_type) {
+        using RowView     = typename T::RowView;
+        using scalar_type = typename T::scalar_type;
+
+        py::class_<RowView> x(m, name, py::buffer_protocol(), row_view_doc);
+        x.def_buffer([](RowView &rv) -> py::buffer_info {
+          return py::buffer_info(
+              rv.size() == 0 ? nullptr
+                             : const_cast<scalar_type *>(&*rv.cbegin()),
+              sizeof(scalar_type),
+              py::format_descriptor<scalar_type>::format(),
+              1,
+              {rv.size()},
+              {sizeof(scalar_type)},
+              true);
+        });
+        return x;
+      }
+
+      template <typename T>
+      py::class_<typename T::RowView>
+      row_view_class(py::module &m, char const *name, std::false_type) {
+        using RowView     = typename T::RowView;
+        using scalar_type = typename T::scalar_type;
+
+        py::class_<RowView> x(m, name, row_view_doc);
+        x.def(
+            "__array__",
+            [](RowView const &rv, py::object dtype, py::object copy) {
+              py::array_t<scalar_type> result(rv.size());
+              std::copy(rv.cbegin(), rv.cend(), result.mutable_data());
+              return copied_array(result, dtype, copy);
+            },
+            py::arg("dtype") = py::none(),
+            py::arg("copy")  = py::none());
+        return x;
+      }
+
+      // A row view refers to the storage of the matrix it was obtained from,
+      // and so the matrix is kept alive for as long as the row view is.
+      template <typename T>
+      void bind_row_view(py::module &m, char const *type_name) {
+        using RowView = typename T::RowView;
+
+        // The row views of some matrices are the row views of other matrices,
+        // for example, the rows of a ProjMaxPlusMat are MaxPlusMat's, in which
+        // case the row view type is already bound.
+        if (py::detail::get_type_info(typeid(RowView))) {
+          return;
+        }
+
+        std::string const name = std::string(type_name) + "RowView";
+        auto x = row_view_class<T>(m, name.c_str(), IsStaticMatrix<T>());
+
+        x.def("__len__", [](RowView const &rv) { return rv.size(); })
+            .def(
+                "__getitem__",
+                [](RowView const &rv, size_t i) {
+                  if (i >= rv.size()) {
+                    throw py::index_error();
+                  }
+                  return *(rv.cbegin() + i);
+                },
+                py::is_operator())
+            .def(
+                "__iter__",
+                [](RowView const &rv) {
+                  return py::make_iterator(rv.cbegin(), rv.cend());
+                },
+                py::keep_alive<0, 1>())
+            .def(
+                "__eq__",
+                [](RowView const &rv, RowView const &that) {
+                  return rv.size() == that.size()
+                         && std::equal(rv.cbegin(), rv.cend(), that.cbegin());
+                },
+                py::is_operator())
+            .def(
+                "__ne__",
+                [](RowView const &rv, RowView const &that) {
+                  return rv.size() != that.size()
+                         || !std::equal(rv.cbegin(), rv.cend(), that.cbegin());
+                },
+                py::is_operator())
+            .def(
+                "__lt__",
+                [](RowView const &rv, RowView const &that) {
+                  return std::lexicographical_compare(
+                      rv.cbegin(), rv.cend(), that.cbegin(), that.cend());
+                },
+                py::is_operator());
+        bind_row_view_row_ops<T>(x, std::is_same<typename T::Row, T>());
+      }
+
+      // Rows of matrices are matrices of the same type, except for some
+      // matrices (such as ProjMaxPlusMat) where they are not, and there is
+      // nothing to bind.
+      template <typename T>
+      void bind_init_from_row_view(py::class_<T> &x, std::true_type) {
+        x.def(py::init([](typename T::RowView const &rv) { return T(rv); }),
+              py::arg("row"));
+        py::implicitly_convertible<typename T::RowView, T>();
+      }
+
+      template <typename T>
+      void bind_init_from_row_view(py::class_<T> &, std::false_type) {}
+
+      // The entries of a static matrix are stored contiguously in row-major
+      // order in the matrix object, and so we can expose them without
+      // copying. The buffer is read-only so that writing to the entries
+      // directly cannot break the invariants of the matrix.
+      template <typename T>
+      py::class_<T>
+      matrix_class(py::module &m, char const *type_name, std::true_type) {
         using scalar_type = typename T::scalar_type;
 
+        py::class_<T> x(m, type_name, py::buffer_protocol());
+        x.def_buffer([](T &x) -> py::buffer_info {
+          size_t const r = x.number_of_rows(), c = x.number_of_cols();
+          return py::buffer_info(r * c == 0 ? nullptr : &*x.begin(),
+                                 sizeof(scalar_type),
+                                 py::format_descriptor<scalar_type>::format(),
+                                 2,
+                                 {r, c},
+                                 {sizeof(scalar_type) * c, sizeof(scalar_type)},
+                                 true);
+        });
+        return x;
+      }
+
+      // The storage of a dynamic matrix can be freed by swap while it is
+      // exported, and so the entries are copied instead.
+      template <typename T>
+      py::class_<T>
+      matrix_class(py::module &m, char const *type_name, std::false_type) {
         py::class_<T> x(m, type_name);
+        x.def(
+            "__array__",
+            [](T const &x, py::object dtype, py::object copy) {
+              return copied_array(copy_to_numpy(x), dtype, copy);
+            },
+            py::arg("dtype") = py::none(),
+            py::arg("copy")  = py::none());
+        return x;
+      }
+
+      template <typename T>
+      auto bind_matrix_common(py::module &m, char const *type_name) {
+        using Row         = typename T::Row;
+        using scalar_type = typename T::scalar_type;
+
+        auto x = matrix_class<T>(m, type_name, IsStaticMatrix<T>());
+
+        bind_row_view<T>(m, type_name);
 
-        // This one has to come before the vector vector one.
-        x.def(py::init<T const &>())
-            .def(pybind11::self > pybind11::self)
+        // These have to come before the vector vector one.
+        x.def(py::init<T const &>());
+        bind_init_from_row_view(x, std::is_same<Row, T>());
+
+        x.def(pybind11::self > pybind11::self)
             .def(pybind11::self != pybind11::self)
             .def("transpose", [](T &x) { x.transpose(); })
             .def(
@@ -93,6 +813,7 @@ namespace libsemigroups {
             .def("one", [](T const &x) { return x.one(); })
             .def(pybind11::self == pybind11::self)
             .def(pybind11::self < pybind11::self)
+            .def("__hash__", [](T const &x) { return Hash<T>()(x); })
             .def("__imul__",
                  [](T &mat, scalar_type a) {
                    mat *= a;
@@ -106,18 +827,91 @@ namespace libsemigroups {
             .def(pybind11::self + pybind11::self)
             .def(pybind11::self * pybind11::self)
             .def("product_inplace", &T::product_inplace)
+            .def(
+                "pow",
+                [](py::object self, py::int_ k) {
+                  return self.attr("__pow__")(k);
+                },
+                py::arg("k"),
+                R"pbdoc(
+                  Returns ``self ** k`` using repeated squaring, which requires
+                  at most ``2 * log2(k)`` products.
+
+                  :param k: the exponent.
+                  :type k: int
+
+                  :return: A :py:class:`Matrix`.
+
+                  :raises RuntimeError: if the matrix is not square.
+                )pbdoc")
+            .def_static("products",
+                        &products<T>,
+                        py::arg("xs"),
+                        py::arg("ys"),
+                        py::arg("number_of_threads") = 1,
+                        R"pbdoc(
+                          Returns the list of the products ``xs[i] * ys[i]``.
+
+                          :param xs: the left-hand factors.
+                          :type xs: List[Matrix]
+                          :param ys: the right-hand factors.
+                          :type ys: List[Matrix]
+                          :param number_of_threads: the number of threads.
+                          :type number_of_threads: int
+
+                          :return: A ``List[Matrix]``.
+                        )pbdoc")
+            .def_static("product",
+                        &product<T>,
+                        py::arg("xs"),
+                        py::arg("number_of_threads") = 1,
+                        R"pbdoc(
+                          Returns the product ``xs[0] * xs[1] * ...``.
+
+                          :param xs: the factors.
+                          :type xs: List[Matrix]
+                          :param number_of_threads: the number of threads.
+                          :type number_of_threads: int
+
+                          :return: A :py:class:`Matrix`.
+                        )pbdoc")
             .def("number_of_rows",
                  [](T const &x) { return x.number_of_rows(); })
             .def("number_of_cols",
                  [](T const &x) { return x.number_of_cols(); })
-            .def("row", [](T const &x, size_t i) { return Row(x.row(i)); })
-            .def("rows", [](T const &x) {
-              std::vector<Row> rs;
-              for (size_t i = 0; i < x.number_of_rows(); ++i) {
-                rs.push_back(Row(x.row(i)));
-              }
-              return rs;
-            });
+            .def(
+                "row",
+                [](T const &x, size_t i) {
+                  if (i >= x.number_of_rows()) {
+                    throw py::index_error();
+                  }
+                  return x.row(i);
+                },
+                py::keep_alive<0, 1>())
+            .def("rows",
+                 [](py::object self) {
+                   T const &x = self.cast<T const &>();
+                   py::list rs;
+                   for (size_t i = 0; i < x.number_of_rows(); ++i) {
+                     py::object rv = py::cast(x.row(i));
+                     py::detail::keep_alive_impl(rv, self);
+                     rs.append(rv);
+                   }
+                   return rs;
+                 })
+            .def(
+                "to_numpy",
+                [](T const &x) { return copy_to_numpy(x); },
+                R"pbdoc(
+                  Returns a new 2-dimensional NumPy array containing a copy of
+                  the entries of the matrix. Infinite entries are represented
+                  by the same integers as in ``libsemigroups``.
+
+                  :Parameters: None
+                  :return: A ``numpy.ndarray``.
+                )pbdoc");
+
+        bind_matrix_pow(x, IsOverFiniteSemiring<T>());
 
         // TODO(later) no implemented in libsemigroups
         // x.def("__iadd__",
@@ -133,10 +927,45 @@ namespace libsemigroups {
         using scalar_type = typename T::scalar_type;
         auto x            = bind_matrix_common<T>(m, type_name);
 
-        x.def(py::init<std::vector<std::vector<scalar_type>> const &>())
+        // The numpy one has to come before the vector vector one, or else
+        // numpy arrays are converted element by element.
+        x.def(py::init([](py::array const &entries) {
+                auto a = to_numpy_array_type<T>(entries);
+                StaticDimensions<T>::validate(a.shape(0), a.shape(1));
+                T result(a.shape(0), a.shape(1));
+                copy_from_numpy(result, a);
+                return result;
+              }),
+              py::arg("entries"))
+            .def(py::init(
+                [](std::vector<std::vector<scalar_type>> const &entries) {
+                  validate_dimensions<T>(entries);
+                  return T(entries);
+                }))
+            .def_static("make",
+                        [](py::array const &entries) {
+                          auto a = to_numpy_array_type<T>(entries);
+                          StaticDimensions<T>::validate(a.shape(0),
+                                                        a.shape(1));
+                          T result(a.shape(0), a.shape(1));
+                          copy_from_numpy(result, a);
+                          validate(result);
+                          return result;
+                        })
+            .def_static(
+                "make",
+                [](std::vector<std::vector<scalar_type>> const &entries) {
+                  validate_dimensions<T>(entries);
+                  T result(entries);
+                  validate(result);
+                  return result;
+                })
             .def("__repr__",
                  [type_name](T const &x) -> std::string {
+                   // Static matrices, such as IntMat3, have the dimension
+                   // as a suffix of their type name.
                    std::string str(type_name);
+                   str.erase(str.find_last_not_of("0123456789") + 1);
                    if (str == "BMat") {
                      str = "Boolean";
                    } else if (str == "IntMat") {
@@ -149,8 +978,39 @@ namespace libsemigroups {
                                         matrix_repr(x).c_str());
                  })
             .def_static("make_identity",
-                        py::overload_cast<size_t>(&T::identity))
-            .def(py::init<size_t, size_t>());
+                        [](size_t n) {
+                          StaticDimensions<T>::validate(n, n);
+                          return T::identity(n);
+                        })
+            .def(py::init([](size_t r, size_t c) {
+              StaticDimensions<T>::validate(r, c);
+              return T(r, c);
+            }));
+      }
+
+      // Binds the matrix type S whose dimensions are template parameters, and
+      // where D is the type of the matrices over the same semiring with
+      // dynamic dimensions. Since Matrix returns an S or a D depending on the
+      // dimensions, S and D matrices with equal entries compare equal.
+      template <typename S, typename D>
+      void bind_static_matrix(py::module &m, char const *type_name) {
+        auto x = bind_matrix_compile<S>(m, type_name);
+        x.def(
+             "__eq__",
+             [](S const &s, D const &d) {
+               return s.number_of_rows() == d.number_of_rows()
+                      && s.number_of_cols() == d.number_of_cols()
+                      && std::equal(s.cbegin(), s.cend(), d.cbegin());
+             },
+             py::is_operator())
+            .def(
+                "__ne__",
+                [](S const &s, D const &d) {
+                  return s.number_of_rows() != d.number_of_rows()
+                         || s.number_of_cols() != d.number_of_cols()
+                         || !std::equal(s.cbegin(), s.cend(), d.cbegin());
+                },
+                py::is_operator());
       }
 
       template <typename T>
@@ -160,18 +1020,36 @@ namespace libsemigroups {
         auto x              = bind_matrix_common<T>(m, type_name);
 
         x.def_static("make",
-                     [](size_t                                       threshold,
-                        std::vector<std::vector<scalar_type>> const &entries) {
-                       // TODO(later) should be T::make but there's no make for
-                       // dynamic runtime matrices and vectors!
-                       auto result
-                           = T(semiring<semiring_type>(threshold), entries);
+                     [](size_t threshold, py::array const &entries) {
+                       auto a      = to_numpy_array_type<T>(entries);
+                       auto result = T(semiring<semiring_type>(threshold),
+                                       a.shape(0),
+                                       a.shape(1));
+                       copy_from_numpy(result, a);
                        validate(result);
                        return result;
                      })
+            .def_static("make",
+                        [](size_t threshold,
+                           std::vector<std::vector<scalar_type>> const
+                               &entries) {
+                          // TODO(later) should be T::make but there's no make
+                          // for dynamic runtime matrices and vectors!
+                          auto result
+                              = T(semiring<semiring_type>(threshold), entries);
+                          validate(result);
+                          return result;
+                        })
             .def(py::init([](size_t threshold, size_t r, size_t c) {
               return T(semiring<semiring_type>(threshold), r, c);
             }))
+            .def(py::init([](size_t threshold, py::array const &entries) {
+              auto a      = to_numpy_array_type<T>(entries);
+              auto result = T(
+                  semiring<semiring_type>(threshold), a.shape(0), a.shape(1));
+              copy_from_numpy(result, a);
+              return result;
+            }))
             .def(py::init(
                 [](size_t                                       threshold,
                    std::vector<std::vector<scalar_type>> const &entries) {
@@ -198,7 +1076,18 @@ namespace libsemigroups {
         using scalar_type   = typename T::scalar_type;
         auto x              = bind_matrix_common<T>(m, type_name);
 
-        x.def_static("make",
+        x.def_static(
+             "make",
+             [](size_t threshold, size_t period, py::array const &entries) {
+               auto a      = to_numpy_array_type<T>(entries);
+               auto result = T(semiring<semiring_type>(threshold, period),
+                               a.shape(0),
+                               a.shape(1));
+               copy_from_numpy(result, a);
+               validate(result);
+               return result;
+             })
+            .def_static("make",
                      [](size_t                                       threshold,
                         size_t                                       period,
                         std::vector<std::vector<scalar_type>> const &entries) {
@@ -209,6 +1098,16 @@ namespace libsemigroups {
                        validate(result);
                        return result;
                      })
+            .def(py::init([](size_t           threshold,
+                             size_t           period,
+                             py::array const &entries) {
+              auto a      = to_numpy_array_type<T>(entries);
+              auto result = T(semiring<semiring_type>(threshold, period),
+                              a.shape(0),
+                              a.shape(1));
+              copy_from_numpy(result, a);
+              return result;
+            }))
             .def(py::init(
                 [](size_t                                       threshold,
                    size_t                                       period,
@@ -241,6 +1140,30 @@ namespace libsemigroups {
     detail::bind_matrix_compile<MaxPlusMat<>>(m, "MaxPlusMat");
     detail::bind_matrix_compile<MinPlusMat<>>(m, "MinPlusMat");
     detail::bind_matrix_compile<ProjMaxPlusMat<>>(m, "ProjMaxPlusMat");
+
+    // Matrices whose dimensions are known at compile time, for the most
+    // commonly used small dimensions.
+    detail::bind_static_matrix<BMat<2>, BMat<>>(m, "BMat2");
+    detail::bind_static_matrix<BMat<3>, BMat<>>(m, "BMat3");
+    detail::bind_static_matrix<BMat<4>, BMat<>>(m, "BMat4");
+    detail::bind_static_matrix<BMat<5>, BMat<>>(m, "BMat5");
+    detail::bind_static_matrix<BMat<6>, BMat<>>(m, "BMat6");
+    detail::bind_static_matrix<IntMat<2>, IntMat<>>(m, "IntMat2");
+    detail::bind_static_matrix<IntMat<3>, IntMat<>>(m, "IntMat3");
+    detail::bind_static_matrix<IntMat<4>, IntMat<>>(m, "IntMat4");
+    detail::bind_static_matrix<IntMat<5>, IntMat<>>(m, "IntMat5");
+    detail::bind_static_matrix<IntMat<6>, IntMat<>>(m, "IntMat6");
+    detail::bind_static_matrix<MaxPlusMat<2>, MaxPlusMat<>>(m, "MaxPlusMat2");
+    detail::bind_static_matrix<MaxPlusMat<3>, MaxPlusMat<>>(m, "MaxPlusMat3");
+    detail::bind_static_matrix<MaxPlusMat<4>, MaxPlusMat<>>(m, "MaxPlusMat4");
+    detail::bind_static_matrix<MaxPlusMat<5>, MaxPlusMat<>>(m, "MaxPlusMat5");
+    detail::bind_static_matrix<MaxPlusMat<6>, MaxPlusMat<>>(m, "MaxPlusMat6");
+    detail::bind_static_matrix<MinPlusMat<2>, MinPlusMat<>>(m, "MinPlusMat2");
+    detail::bind_static_matrix<MinPlusMat<3>, MinPlusMat<>>(m, "MinPlusMat3");
+    detail::bind_static_matrix<MinPlusMat<4>, MinPlusMat<>>(m, "MinPlusMat4");
+    detail::bind_static_matrix<MinPlusMat<5>, MinPlusMat<>>(m, "MinPlusMat5");
+    detail::bind_static_matrix<MinPlusMat<6>, MinPlusMat<>>(m, "MinPlusMat6");
+
     detail::bind_matrix_run<MaxPlusTruncMat<>>(m, "MaxPlusTruncMat");
     detail::bind_matrix_run<MinPlusTruncMat<>>(m, "MinPlusTruncMat");
     detail::bind_ntp_matrix(m, "NTPMat");
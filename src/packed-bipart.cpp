@@ -0,0 +1,269 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <string>
+#include <vector>
+
+#include <pybind11/chrono.h>
+#include <pybind11/functional.h>
+#include <pybind11/operators.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <libsemigroups/libsemigroups.hpp>
+
+#include "main.hpp"
+#include "packed-bipart.hpp"
+
+namespace py = pybind11;
+
+namespace libsemigroups {
+  namespace {
+    void validate_point(PackedBipartition const &x, size_t i) {
+      if (i >= 2 * x.degree()) {
+        LIBSEMIGROUPS_EXCEPTION("expected a point less than %llu, found %llu",
+                                static_cast<uint64_t>(2 * x.degree()),
+                                static_cast<uint64_t>(i));
+      }
+    }
+
+    void validate_degrees(PackedBipartition const &x,
+                          PackedBipartition const &y) {
+      if (x.degree() != y.degree()) {
+        LIBSEMIGROUPS_EXCEPTION("expected bipartitions of equal degree, "
+                                "found %llu and %llu",
+                                static_cast<uint64_t>(x.degree()),
+                                static_cast<uint64_t>(y.degree()));
+      }
+    }
+  }  // namespace
+
+  void init_packed_bipart(py::module &m) {
+    py::class_<PackedBipartition>(m,
+                                  "PackedBipartition",
+                                  R"pbdoc(
+      Class for bipartitions of degree at most 32, where the index of the
+      block containing each point is stored in a single byte. The product of
+      two such bipartitions does not allocate any memory, and so is much
+      faster than the product of two :py:class:`Bipartition` objects.
+    )pbdoc")
+        .def(py::init<>())
+        .def(py::init<PackedBipartition const &>())
+        .def(py::init<std::vector<uint32_t> const &>(),
+             py::arg("lookup"),
+             R"pbdoc(
+               Constructs a bipartition from the list of the indices of the
+               blocks containing its points, as in :py:meth:`Bipartition.make`.
+               The blocks are renumbered in the order in which they first
+               occur in ``lookup``.
+
+               :param lookup: the indices of the blocks.
+               :type lookup: List[int]
+
+               :raises RuntimeError:
+                 if ``lookup`` does not have even length at most ``64``.
+             )pbdoc")
+        .def(py::init<Bipartition const &>(),
+             py::arg("x"),
+             R"pbdoc(
+               Constructs a bipartition equal to the :py:class:`Bipartition`
+               ``x``.
+
+               :param x: the bipartition.
+               :type x: Bipartition
+
+               :raises RuntimeError:
+                 if the degree of ``x`` is greater than ``32``.
+             )pbdoc")
+        .def(py::self == py::self)
+        .def(py::self != py::self)
+        .def(py::self < py::self)
+        .def("__hash__", &PackedBipartition::hash_value)
+        .def(
+            "__mul__",
+            [](PackedBipartition const &x, PackedBipartition const &y) {
+              validate_degrees(x, y);
+              return x * y;
+            },
+            py::is_operator())
+        .def(
+            "product_inplace",
+            [](PackedBipartition       &xy,
+               PackedBipartition const &x,
+               PackedBipartition const &y) {
+              validate_degrees(x, y);
+              validate_degrees(xy, x);
+              if (&xy == &x || &xy == &y) {
+                LIBSEMIGROUPS_EXCEPTION(
+                    "cannot compute the product in place of one of its "
+                    "arguments");
+              }
+              xy.product_inplace(x, y);
+            },
+            py::arg("x"),
+            py::arg("y"),
+            R"pbdoc(
+              Sets ``self`` to the product of ``x`` and ``y``, without
+              allocating any memory.
+
+              :param x: the left-hand factor.
+              :type x: PackedBipartition
+              :param y: the right-hand factor.
+              :type y: PackedBipartition
+
+              :return: (None)
+
+              :raises RuntimeError:
+                if ``x``, ``y`` and ``self`` do not have equal degrees, or
+                ``self`` is ``x`` or ``y``.
+            )pbdoc")
+        .def(
+            "__getitem__",
+            [](PackedBipartition const &x, size_t i) {
+              validate_point(x, i);
+              return x.at(i);
+            },
+            py::arg("i"),
+            py::is_operator(),
+            R"pbdoc(
+              Returns the index of the block containing the point ``i``.
+
+              :param i: the point.
+              :type i: int
+
+              :return: An ``int``.
+
+              :raises RuntimeError: if ``i`` is out of bounds.
+            )pbdoc")
+        .def("degree",
+             &PackedBipartition::degree,
+             R"pbdoc(
+               Returns the degree of ``self``.
+
+               :Parameters: None
+               :return: An ``int``.
+             )pbdoc")
+        .def("number_of_blocks",
+             &PackedBipartition::number_of_blocks,
+             R"pbdoc(
+               Returns the number of blocks.
+
+               :Parameters: None
+               :return: An ``int``.
+             )pbdoc")
+        .def("number_of_left_blocks",
+             &PackedBipartition::number_of_left_blocks,
+             R"pbdoc(
+               Returns the number of blocks containing a point less than
+               :py:meth:`degree`.
+
+               :Parameters: None
+               :return: An ``int``.
+             )pbdoc")
+        .def("number_of_right_blocks",
+             &PackedBipartition::number_of_right_blocks,
+             R"pbdoc(
+               Returns the number of blocks containing a point not less than
+               :py:meth:`degree`.
+
+               :Parameters: None
+               :return: An ``int``.
+             )pbdoc")
+        .def("rank",
+             &PackedBipartition::rank,
+             R"pbdoc(
+               Returns the number of transverse blocks.
+
+               :Parameters: None
+               :return: An ``int``.
+             )pbdoc")
+        .def(
+            "is_transverse_block",
+            [](PackedBipartition const &x, size_t i) {
+              if (i >= x.number_of_blocks()) {
+                LIBSEMIGROUPS_EXCEPTION(
+                    "expected a block index less than %llu, found %llu",
+                    static_cast<uint64_t>(x.number_of_blocks()),
+                    static_cast<uint64_t>(i));
+              }
+              return x.is_transverse_block(i);
+            },
+            py::arg("i"),
+            R"pbdoc(
+              Returns ``True`` if the block with index ``i`` contains points
+              both less than, and not less than, :py:meth:`degree`.
+
+              :param i: the index of a block.
+              :type i: int
+
+              :return: A ``bool``.
+
+              :raises RuntimeError: if ``i`` is out of bounds.
+            )pbdoc")
+        .def("lookup",
+             &PackedBipartition::lookup,
+             R"pbdoc(
+               Returns the list of the indices of the blocks containing the
+               points of ``self``.
+
+               :Parameters: None
+               :return: A ``List[int]``.
+             )pbdoc")
+        .def("to_bipartition",
+             &PackedBipartition::to_bipartition,
+             R"pbdoc(
+               Returns the :py:class:`Bipartition` equal to ``self``.
+
+               :Parameters: None
+               :return: A :py:class:`Bipartition`.
+             )pbdoc")
+        .def(
+            "one",
+            [](PackedBipartition const &x) {
+              return PackedBipartition::identity(x.degree());
+            },
+            R"pbdoc(
+              Returns the identity bipartition with the same degree as
+              ``self``.
+
+              :Parameters: None
+              :return: A :py:class:`PackedBipartition`.
+            )pbdoc")
+        .def_static("identity",
+                    &PackedBipartition::identity,
+                    py::arg("n"),
+                    R"pbdoc(
+                      Returns the identity bipartition of degree ``n``.
+
+                      :param n: the degree.
+                      :type n: int
+
+                      :return: A :py:class:`PackedBipartition`.
+
+                      :raises RuntimeError: if ``n`` is greater than ``32``.
+                    )pbdoc")
+        .def("__repr__", [](PackedBipartition const &x) {
+          std::string result = "PackedBipartition([";
+          for (size_t i = 0; i < 2 * x.degree(); ++i) {
+            result += (i == 0 ? "" : ", ");
+            result += detail::to_string(x.at(i));
+          }
+          return result + "])";
+        });
+  }
+}  // namespace libsemigroups
@@ -0,0 +1,298 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the declaration of the class PackedBipartition, which is
+// a bipartition of degree at most 32, stored as the index of the block
+// containing each point in a fixed size array of bytes, and the adapters
+// required to use it as the element type of a FroidurePin.
+
+#ifndef SRC_PACKED_BIPART_HPP_
+#define SRC_PACKED_BIPART_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include <libsemigroups/libsemigroups.hpp>
+
+#include "pool.hpp"
+
+namespace libsemigroups {
+
+  class PackedBipartition {
+   public:
+    using index_type = uint8_t;
+
+    static constexpr size_t max_degree = 32;
+
+    PackedBipartition() : _n(0), _number_of_blocks(0), _lookup() {}
+
+    // Constructs the bipartition where lookup[i] is the index of the block
+    // containing the point i, as in Bipartition::make. The blocks are
+    // renumbered in the order in which they first occur in lookup.
+    explicit PackedBipartition(std::vector<uint32_t> const& lookup)
+        : PackedBipartition() {
+      if (lookup.size() % 2 != 0 || lookup.size() > 2 * max_degree) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "expected a list of even length at most %llu, found length %llu",
+            static_cast<uint64_t>(2 * max_degree),
+            static_cast<uint64_t>(lookup.size()));
+      }
+      _n = lookup.size() / 2;
+      std::vector<uint32_t> labels;
+      for (size_t i = 0; i < lookup.size(); ++i) {
+        auto it = std::find(labels.cbegin(), labels.cend(), lookup[i]);
+        if (it == labels.cend()) {
+          labels.push_back(lookup[i]);
+          it = labels.cend() - 1;
+        }
+        _lookup[i] = static_cast<index_type>(it - labels.cbegin());
+      }
+      _number_of_blocks = labels.size();
+    }
+
+    explicit PackedBipartition(Bipartition const& x)
+        : PackedBipartition(
+            std::vector<uint32_t>(x.cbegin(), x.cend())) {}
+
+    PackedBipartition(PackedBipartition const&) = default;
+    PackedBipartition(PackedBipartition&&)      = default;
+    PackedBipartition& operator=(PackedBipartition const&) = default;
+    PackedBipartition& operator=(PackedBipartition&&) = default;
+
+    // The objects allocated with new, such as the elements stored in a
+    // FroidurePin, are allocated from a pool, see pool.hpp.
+    static void* operator new(size_t size) {
+      return detail::Pool<PackedBipartition>::allocate(size);
+    }
+
+    static void operator delete(void* ptr, size_t size) noexcept {
+      detail::Pool<PackedBipartition>::deallocate(ptr, size);
+    }
+
+    static PackedBipartition identity(size_t n) {
+      std::vector<uint32_t> lookup(2 * n);
+      std::iota(lookup.begin(), lookup.begin() + n, 0);
+      std::iota(lookup.begin() + n, lookup.end(), 0);
+      return PackedBipartition(lookup);
+    }
+
+    size_t degree() const noexcept {
+      return _n;
+    }
+
+    size_t number_of_blocks() const noexcept {
+      return _number_of_blocks;
+    }
+
+    // Returns the index of the block containing the point i.
+    size_t at(size_t i) const noexcept {
+      return _lookup[i];
+    }
+
+    // The blocks containing the points 0, ..., n - 1 are numbered first.
+    size_t number_of_left_blocks() const noexcept {
+      return _n == 0 ? 0 : *std::max_element(_lookup.cbegin(),
+                                             _lookup.cbegin() + _n)
+                               + 1;
+    }
+
+    size_t number_of_right_blocks() const noexcept {
+      return count(block_mask(_n, 2 * _n));
+    }
+
+    // Returns the number of blocks containing points in both {0, ..., n - 1}
+    // and {n, ..., 2n - 1}.
+    size_t rank() const noexcept {
+      return count(block_mask(0, _n) & block_mask(_n, 2 * _n));
+    }
+
+    bool is_transverse_block(size_t i) const noexcept {
+      return ((block_mask(0, _n) & block_mask(_n, 2 * _n)) >> i) & 1;
+    }
+
+    // Sets this to x * y. The blocks of x and y are fused with a union-find
+    // whose scratch space is on the stack, and so the product does not
+    // allocate any memory. This must not be x or y.
+    void product_inplace(PackedBipartition const& x,
+                         PackedBipartition const& y) noexcept {
+      size_t const                           n  = _n;
+      size_t const                           nx = x._number_of_blocks;
+      std::array<index_type, 4 * max_degree> fuse, label;
+
+      std::iota(fuse.begin(), fuse.begin() + nx + y._number_of_blocks, 0);
+      for (size_t i = 0; i < n; ++i) {
+        index_type const a = find(fuse, x._lookup[n + i]);
+        index_type const b = find(fuse, nx + y._lookup[i]);
+        if (a < b) {
+          fuse[b] = a;
+        } else if (b < a) {
+          fuse[a] = b;
+        }
+      }
+
+      std::fill(label.begin(), label.begin() + nx + y._number_of_blocks, 0);
+      index_type next = 0;
+      for (size_t i = 0; i < 2 * n; ++i) {
+        index_type const r = (i < n ? find(fuse, x._lookup[i])
+                                    : find(fuse, nx + y._lookup[i]));
+        if (label[r] == 0) {
+          label[r] = ++next;
+        }
+        _lookup[i] = label[r] - 1;
+      }
+      _number_of_blocks = next;
+    }
+
+    PackedBipartition operator*(PackedBipartition const& y) const {
+      PackedBipartition result(*this);
+      result.product_inplace(*this, y);
+      return result;
+    }
+
+    bool operator==(PackedBipartition const& that) const noexcept {
+      return _n == that._n
+             && std::equal(_lookup.cbegin(),
+                           _lookup.cbegin() + 2 * _n,
+                           that._lookup.cbegin());
+    }
+
+    bool operator!=(PackedBipartition const& that) const noexcept {
+      return !(*this == that);
+    }
+
+    bool operator<(PackedBipartition const& that) const noexcept {
+      return _n < that._n
+             || (_n == that._n
+                 && std::lexicographical_compare(
+                     _lookup.cbegin(),
+                     _lookup.cbegin() + 2 * _n,
+                     that._lookup.cbegin(),
+                     that._lookup.cbegin() + 2 * _n));
+    }
+
+    size_t hash_value() const noexcept {
+      size_t seed = _n;
+      for (size_t i = 0; i < 2 * _n; ++i) {
+        seed ^= std::hash<index_type>()(_lookup[i]) + 0x9e3779b97f4a7c16
+                + (seed << 6) + (seed >> 2);
+      }
+      return seed;
+    }
+
+    std::vector<uint32_t> lookup() const {
+      return std::vector<uint32_t>(_lookup.cbegin(),
+                                   _lookup.cbegin() + 2 * _n);
+    }
+
+    Bipartition to_bipartition() const {
+      return Bipartition::make(lookup());
+    }
+
+   private:
+    static index_type find(std::array<index_type, 4 * max_degree>& fuse,
+                           index_type                              i) noexcept {
+      while (fuse[i] != i) {
+        fuse[i] = fuse[fuse[i]];
+        i       = fuse[i];
+      }
+      return i;
+    }
+
+    // Returns the set of blocks containing the points first, ..., last - 1.
+    uint64_t block_mask(size_t first, size_t last) const noexcept {
+      uint64_t result = 0;
+      for (size_t i = first; i < last; ++i) {
+        result |= uint64_t(1) << _lookup[i];
+      }
+      return result;
+    }
+
+    static size_t count(uint64_t w) noexcept {
+      size_t result = 0;
+      for (; w != 0; w &= w - 1) {
+        ++result;
+      }
+      return result;
+    }
+
+    size_t                                 _n;
+    size_t                                 _number_of_blocks;
+    std::array<index_type, 2 * max_degree> _lookup;
+  };
+
+  ////////////////////////////////////////////////////////////////////////
+  // Adapters
+  ////////////////////////////////////////////////////////////////////////
+
+  template <>
+  struct Complexity<PackedBipartition> {
+    size_t operator()(PackedBipartition const& x) const noexcept {
+      return x.degree();
+    }
+  };
+
+  template <>
+  struct Degree<PackedBipartition> {
+    size_t operator()(PackedBipartition const& x) const noexcept {
+      return x.degree();
+    }
+  };
+
+  template <>
+  struct IncreaseDegree<PackedBipartition> {
+    void operator()(PackedBipartition&, size_t) const noexcept {}
+  };
+
+  template <>
+  struct One<PackedBipartition> {
+    PackedBipartition operator()(PackedBipartition const& x) const {
+      return PackedBipartition::identity(x.degree());
+    }
+
+    PackedBipartition operator()(size_t n) const {
+      return PackedBipartition::identity(n);
+    }
+  };
+
+  template <>
+  struct Product<PackedBipartition> {
+    void operator()(PackedBipartition&       xy,
+                    PackedBipartition const& x,
+                    PackedBipartition const& y,
+                    size_t = 0) const noexcept {
+      xy.product_inplace(x, y);
+    }
+  };
+}  // namespace libsemigroups
+
+namespace std {
+  template <>
+  struct hash<libsemigroups::PackedBipartition> {
+    size_t
+    operator()(libsemigroups::PackedBipartition const& x) const noexcept {
+      return x.hash_value();
+    }
+  };
+}  // namespace std
+
+#endif  // SRC_PACKED_BIPART_HPP_
@@ -0,0 +1,316 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <pybind11/chrono.h>
+#include <pybind11/functional.h>
+#include <pybind11/operators.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <libsemigroups/libsemigroups.hpp>
+
+#include "main.hpp"
+#include "packed-bmat.hpp"
+
+namespace py = pybind11;
+
+namespace libsemigroups {
+  namespace {
+    void validate_entry(PackedBMat const &x, size_t i, size_t j) {
+      if (i >= x.degree() || j >= x.degree()) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "expected indices less than %llu, found (%llu, %llu)",
+            static_cast<uint64_t>(x.degree()),
+            static_cast<uint64_t>(i),
+            static_cast<uint64_t>(j));
+      }
+    }
+
+    void validate_degrees(PackedBMat const &x, PackedBMat const &y) {
+      if (x.degree() != y.degree()) {
+        LIBSEMIGROUPS_EXCEPTION("expected matrices of equal degree, found "
+                                "%llu and %llu",
+                                static_cast<uint64_t>(x.degree()),
+                                static_cast<uint64_t>(y.degree()));
+      }
+    }
+
+    // Mat is BMat<> or BMat<N> for some N, the latter are returned by
+    // Matrix(MatrixKind.Boolean, rows) when rows is N x N for N in 2, ..., 6.
+    template <typename Mat>
+    PackedBMat packed_bmat(Mat const &x) {
+      if (x.number_of_rows() != x.number_of_cols()) {
+        LIBSEMIGROUPS_EXCEPTION("expected a square matrix, found %llux%llu",
+                                static_cast<uint64_t>(x.number_of_rows()),
+                                static_cast<uint64_t>(x.number_of_cols()));
+      }
+      PackedBMat result(x.number_of_rows());
+      for (size_t i = 0; i < x.number_of_rows(); ++i) {
+        for (size_t j = 0; j < x.number_of_cols(); ++j) {
+          result.set(i, j, x(i, j));
+        }
+      }
+      return result;
+    }
+  }  // namespace
+
+  void init_packed_bmat(py::module &m) {
+    py::class_<PackedBMat>(m,
+                           "PackedBMat",
+                           R"pbdoc(
+      Class for square boolean matrices of arbitrary dimension, where each row
+      is packed into 64-bit blocks. The product of two such matrices is
+      computed 64 entries at a time, and so is much faster than the product
+      of two :py:class:`Matrix` objects of kind
+      :py:attr:`MatrixKind.Boolean`, which use one integer per entry.
+    )pbdoc")
+        .def(py::init<size_t>(),
+             py::arg("n"),
+             R"pbdoc(
+               Constructs the ``n`` x ``n`` zero matrix.
+
+               :param n: the dimension.
+               :type n: int
+             )pbdoc")
+        .def(py::init<PackedBMat const &>())
+        .def(py::init<std::vector<std::vector<bool>> const &>(),
+             py::arg("rows"),
+             R"pbdoc(
+               Constructs a matrix from a list of rows, each of which is a
+               list of truthy or falsy values.
+
+               :param rows: the rows of the matrix.
+               :type rows: List[List[bool]]
+
+               :raises RuntimeError: if ``rows`` is not square.
+             )pbdoc")
+        .def(py::init(&packed_bmat<BMat<>>),
+             py::arg("x"),
+             R"pbdoc(
+               Constructs a matrix with the same entries as the
+               :py:class:`Matrix` ``x`` of kind :py:attr:`MatrixKind.Boolean`,
+               with any dimension, including the matrices ``BMat2``, ...,
+               ``BMat6`` with compile-time dimensions.
+
+               :param x: the matrix.
+               :type x: Matrix
+
+               :raises RuntimeError: if ``x`` is not square.
+             )pbdoc")
+        .def(py::init(&packed_bmat<BMat<2>>), py::arg("x"))
+        .def(py::init(&packed_bmat<BMat<3>>), py::arg("x"))
+        .def(py::init(&packed_bmat<BMat<4>>), py::arg("x"))
+        .def(py::init(&packed_bmat<BMat<5>>), py::arg("x"))
+        .def(py::init(&packed_bmat<BMat<6>>), py::arg("x"))
+        .def(py::self == py::self)
+        .def(py::self != py::self)
+        .def(py::self < py::self)
+        .def("__hash__", &PackedBMat::hash_value)
+        .def(
+            "__mul__",
+            [](PackedBMat const &x, PackedBMat const &y) {
+              validate_degrees(x, y);
+              return x * y;
+            },
+            py::is_operator())
+        .def(
+            "product_inplace",
+            [](PackedBMat &xy, PackedBMat const &x, PackedBMat const &y) {
+              validate_degrees(x, y);
+              validate_degrees(xy, x);
+              if (&xy == &x || &xy == &y) {
+                LIBSEMIGROUPS_EXCEPTION(
+                    "cannot compute the product in place of one of its "
+                    "arguments");
+              }
+              xy.product_inplace(x, y);
+            },
+            py::arg("x"),
+            py::arg("y"),
+            R"pbdoc(
+              Sets ``self`` to the product of ``x`` and ``y``, without
+              allocating any memory.
+
+              :param x: the left-hand factor.
+              :type x: PackedBMat
+              :param y: the right-hand factor.
+              :type y: PackedBMat
+
+              :return: (None)
+
+              :raises RuntimeError:
+                if ``x``, ``y`` and ``self`` do not have equal degrees, or
+                ``self`` is ``x`` or ``y``.
+            )pbdoc")
+        .def(
+            "get",
+            [](PackedBMat const &x, size_t i, size_t j) {
+              validate_entry(x, i, j);
+              return x.get(i, j);
+            },
+            py::arg("i"),
+            py::arg("j"),
+            R"pbdoc(
+              Returns the entry in the (i, j)th position.
+
+              :param i: the row index.
+              :type i: int
+              :param j: the column index.
+              :type j: int
+
+              :return: A ``bool``.
+
+              :raises RuntimeError: if ``i`` or ``j`` is out of bounds.
+            )pbdoc")
+        .def(
+            "set",
+            [](PackedBMat &x, size_t i, size_t j, bool val) {
+              validate_entry(x, i, j);
+              x.set(i, j, val);
+            },
+            py::arg("i"),
+            py::arg("j"),
+            py::arg("val"),
+            R"pbdoc(
+              Sets the (i, j)th entry to ``val``.
+
+              :param i: the row index.
+              :type i: int
+              :param j: the column index.
+              :type j: int
+              :param val: the value.
+              :type val: bool
+
+              :return: (None)
+
+              :raises RuntimeError: if ``i`` or ``j`` is out of bounds.
+            )pbdoc")
+        .def("degree",
+             &PackedBMat::degree,
+             R"pbdoc(
+               Returns the number of rows (and columns) of ``self``.
+
+               :Parameters: None
+               :return: An ``int``.
+             )pbdoc")
+        .def("transpose",
+             &PackedBMat::transpose,
+             R"pbdoc(
+               Returns the transpose of ``self``.
+
+               :Parameters: None
+               :return: A :py:class:`PackedBMat`.
+             )pbdoc")
+        .def("swap",
+             [](PackedBMat &x, PackedBMat &y) { std::swap(x, y); },
+             py::arg("other"),
+             R"pbdoc(
+               Swaps the contents of ``self`` and ``other``.
+
+               :param other: the matrix to swap with.
+               :type other: PackedBMat
+
+               :return: (None)
+             )pbdoc")
+        .def("rows",
+             &PackedBMat::rows,
+             R"pbdoc(
+               Returns the rows of ``self`` as lists of ``bool``.
+
+               :Parameters: None
+               :return: A ``List[List[bool]]``.
+             )pbdoc")
+        .def("row_space_basis",
+             &PackedBMat::row_space_basis,
+             R"pbdoc(
+               Returns a :py:class:`PackedBMat` whose non-zero rows form a
+               basis for the row space of ``self``. The basis rows come first,
+               followed by zero rows.
+
+               :Parameters: None
+               :return: A :py:class:`PackedBMat`.
+             )pbdoc")
+        .def("col_space_basis",
+             &PackedBMat::col_space_basis,
+             R"pbdoc(
+               Returns a :py:class:`PackedBMat` whose non-zero columns form a
+               basis for the column space of ``self``.
+
+               :Parameters: None
+               :return: A :py:class:`PackedBMat`.
+             )pbdoc")
+        .def("row_space_size",
+             &PackedBMat::row_space_size,
+             py::call_guard<py::gil_scoped_release>(),
+             R"pbdoc(
+               Returns the size of the row space of ``self``, including the
+               zero row. The row space is enumerated, and so this can take
+               time exponential in the degree.
+
+               :Parameters: None
+               :return: An ``int``.
+             )pbdoc")
+        .def("column_space_size",
+             &PackedBMat::col_space_size,
+             py::call_guard<py::gil_scoped_release>(),
+             R"pbdoc(
+               Returns the size of the column space of ``self``, including the
+               zero column.
+
+               :Parameters: None
+               :return: An ``int``.
+             )pbdoc")
+        .def(
+            "one",
+            [](PackedBMat const &x) {
+              return PackedBMat::identity(x.degree());
+            },
+            R"pbdoc(
+              Returns the identity matrix with the same degree as ``self``.
+
+              :Parameters: None
+              :return: A :py:class:`PackedBMat`.
+            )pbdoc")
+        .def_static("identity",
+                    &PackedBMat::identity,
+                    py::arg("n"),
+                    R"pbdoc(
+                      Returns the ``n`` x ``n`` identity matrix.
+
+                      :param n: the dimension.
+                      :type n: int
+
+                      :return: A :py:class:`PackedBMat`.
+                    )pbdoc")
+        .def("__repr__", [](PackedBMat const &x) {
+          std::string result = "PackedBMat([";
+          for (size_t i = 0; i < x.degree(); ++i) {
+            result += (i == 0 ? "[" : ", [");
+            for (size_t j = 0; j < x.degree(); ++j) {
+              result += (j == 0 ? "" : ", ");
+              result += (x.get(i, j) ? "1" : "0");
+            }
+            result += "]";
+          }
+          if (x.degree() == 0) {
+            return std::string("PackedBMat(0)");
+          }
+          return result + "])";
+        });
+  }
+}  // namespace libsemigroups
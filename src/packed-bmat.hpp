@@ -0,0 +1,348 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the declaration of the class PackedBMat, which is a
+// square Boolean matrix of arbitrary dimension, where each row is packed
+// into 64-bit blocks, and the adapters required to use it as the element type
+// of a FroidurePin.
+
+#ifndef SRC_PACKED_BMAT_HPP_
+#define SRC_PACKED_BMAT_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <set>
+#include <vector>
+
+#include <libsemigroups/libsemigroups.hpp>
+
+namespace libsemigroups {
+
+  class PackedBMat {
+   public:
+    using block_type = uint64_t;
+
+    static constexpr size_t block_size = 64;
+
+    PackedBMat() : PackedBMat(0) {}
+
+    // Constructs the n x n zero matrix.
+    explicit PackedBMat(size_t n)
+        : _n(n),
+          _blocks_per_row((n + block_size - 1) / block_size),
+          _data(_n * _blocks_per_row, 0) {}
+
+    explicit PackedBMat(std::vector<std::vector<bool>> const& rows)
+        : PackedBMat(rows.size()) {
+      for (size_t i = 0; i < _n; ++i) {
+        if (rows[i].size() != _n) {
+          LIBSEMIGROUPS_EXCEPTION(
+              "expected a square matrix, found row %llu of length %llu "
+              "in a matrix with %llu rows",
+              static_cast<uint64_t>(i),
+              static_cast<uint64_t>(rows[i].size()),
+              static_cast<uint64_t>(_n));
+        }
+        for (size_t j = 0; j < _n; ++j) {
+          set(i, j, rows[i][j]);
+        }
+      }
+    }
+
+    PackedBMat(PackedBMat const&) = default;
+    PackedBMat(PackedBMat&&)      = default;
+    PackedBMat& operator=(PackedBMat const&) = default;
+    PackedBMat& operator=(PackedBMat&&) = default;
+
+    static PackedBMat identity(size_t n) {
+      PackedBMat result(n);
+      for (size_t i = 0; i < n; ++i) {
+        result.set(i, i, true);
+      }
+      return result;
+    }
+
+    size_t degree() const noexcept {
+      return _n;
+    }
+
+    size_t blocks_per_row() const noexcept {
+      return _blocks_per_row;
+    }
+
+    bool get(size_t i, size_t j) const noexcept {
+      return (row(i)[j / block_size] >> (j % block_size)) & 1;
+    }
+
+    void set(size_t i, size_t j, bool val) noexcept {
+      block_type& b    = row(i)[j / block_size];
+      block_type  mask = block_type(1) << (j % block_size);
+      if (val) {
+        b |= mask;
+      } else {
+        b &= ~mask;
+      }
+    }
+
+    // Sets this to x * y. Row i of the product is the union of the rows k of
+    // y such that x(i, k) = 1, and so the product is computed a whole block
+    // of 64 entries at a time. This must not be x or y.
+    void product_inplace(PackedBMat const& x, PackedBMat const& y) noexcept {
+      std::fill(_data.begin(), _data.end(), 0);
+      for (size_t i = 0; i < _n; ++i) {
+        block_type*       out = row(i);
+        block_type const* xi  = x.row(i);
+        for (size_t b = 0; b < _blocks_per_row; ++b) {
+          block_type w = xi[b];
+          while (w != 0) {
+            size_t const      k  = b * block_size + trailing_zeros(w);
+            block_type const* yk = y.row(k);
+            for (size_t c = 0; c < _blocks_per_row; ++c) {
+              out[c] |= yk[c];
+            }
+            w &= w - 1;
+          }
+        }
+      }
+    }
+
+    PackedBMat operator*(PackedBMat const& y) const {
+      PackedBMat result(_n);
+      result.product_inplace(*this, y);
+      return result;
+    }
+
+    bool operator==(PackedBMat const& that) const noexcept {
+      return _n == that._n && _data == that._data;
+    }
+
+    bool operator!=(PackedBMat const& that) const noexcept {
+      return !(*this == that);
+    }
+
+    bool operator<(PackedBMat const& that) const noexcept {
+      return _n < that._n || (_n == that._n && _data < that._data);
+    }
+
+    size_t hash_value() const noexcept {
+      size_t seed = _n;
+      for (auto b : _data) {
+        seed ^= std::hash<block_type>()(b) + 0x9e3779b97f4a7c16 + (seed << 6)
+                + (seed >> 2);
+      }
+      return seed;
+    }
+
+    PackedBMat transpose() const {
+      PackedBMat result(_n);
+      for (size_t i = 0; i < _n; ++i) {
+        for (size_t j = 0; j < _n; ++j) {
+          if (get(i, j)) {
+            result.set(j, i, true);
+          }
+        }
+      }
+      return result;
+    }
+
+    // Returns a matrix whose non-zero rows form a basis for the row space of
+    // this, i.e. the distinct non-zero rows which are not the union of the
+    // other rows they contain. The basis rows are sorted, and come first.
+    PackedBMat row_space_basis() const {
+      std::vector<std::vector<block_type>> rows;
+      for (size_t i = 0; i < _n; ++i) {
+        std::vector<block_type> r(row(i), row(i) + _blocks_per_row);
+        if (std::any_of(r.cbegin(), r.cend(), [](block_type b) {
+              return b != 0;
+            })) {
+          rows.push_back(std::move(r));
+        }
+      }
+      std::sort(rows.begin(), rows.end());
+      rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+      PackedBMat result(_n);
+      size_t     next = 0;
+      for (auto const& r : rows) {
+        std::vector<block_type> un(_blocks_per_row, 0);
+        for (auto const& s : rows) {
+          if (s != r && is_subset(s, r)) {
+            for (size_t c = 0; c < _blocks_per_row; ++c) {
+              un[c] |= s[c];
+            }
+          }
+        }
+        if (un != r) {
+          std::copy(r.cbegin(), r.cend(), result.row(next++));
+        }
+      }
+      return result;
+    }
+
+    PackedBMat col_space_basis() const {
+      return transpose().row_space_basis().transpose();
+    }
+
+    // Returns the number of distinct unions of rows, including the empty
+    // union. The elements of the row space are enumerated, and so this can
+    // be exponential in the degree.
+    size_t row_space_size() const {
+      PackedBMat const                     basis = row_space_basis();
+      std::set<std::vector<block_type>>    seen;
+      std::vector<std::vector<block_type>> queue;
+      queue.emplace_back(_blocks_per_row, 0);
+      seen.insert(queue.back());
+      for (size_t q = 0; q < queue.size(); ++q) {
+        for (size_t i = 0; i < _n; ++i) {
+          block_type const* r = basis.row(i);
+          if (std::all_of(r, r + _blocks_per_row, [](block_type b) {
+                return b == 0;
+              })) {
+            break;
+          }
+          std::vector<block_type> un(queue[q]);
+          for (size_t c = 0; c < _blocks_per_row; ++c) {
+            un[c] |= r[c];
+          }
+          if (seen.insert(un).second) {
+            queue.push_back(std::move(un));
+          }
+        }
+      }
+      return seen.size();
+    }
+
+    size_t col_space_size() const {
+      return transpose().row_space_size();
+    }
+
+    std::vector<std::vector<bool>> rows() const {
+      std::vector<std::vector<bool>> result(_n, std::vector<bool>(_n, false));
+      for (size_t i = 0; i < _n; ++i) {
+        for (size_t j = 0; j < _n; ++j) {
+          result[i][j] = get(i, j);
+        }
+      }
+      return result;
+    }
+
+   private:
+    block_type* row(size_t i) noexcept {
+      return _data.data() + i * _blocks_per_row;
+    }
+
+    block_type const* row(size_t i) const noexcept {
+      return _data.data() + i * _blocks_per_row;
+    }
+
+    static bool is_subset(std::vector<block_type> const& s,
+                          std::vector<block_type> const& r) noexcept {
+      for (size_t c = 0; c < s.size(); ++c) {
+        if ((s[c] & ~r[c]) != 0) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    static size_t trailing_zeros(block_type w) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_ctzll(w);
+#else
+      size_t result = 0;
+      while ((w & 1) == 0) {
+        w >>= 1;
+        ++result;
+      }
+      return result;
+#endif
+    }
+
+    size_t                  _n;
+    size_t                  _blocks_per_row;
+    std::vector<block_type> _data;
+  };
+
+  inline std::ostream& operator<<(std::ostream& os, PackedBMat const& x) {
+    for (size_t i = 0; i < x.degree(); ++i) {
+      for (size_t j = 0; j < x.degree(); ++j) {
+        os << (x.get(i, j) ? '1' : '0');
+      }
+      os << '\n';
+    }
+    return os;
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // Adapters
+  ////////////////////////////////////////////////////////////////////////
+
+  template <>
+  struct Complexity<PackedBMat> {
+    size_t operator()(PackedBMat const& x) const noexcept {
+      return x.degree() * x.degree() * x.blocks_per_row();
+    }
+  };
+
+  template <>
+  struct Degree<PackedBMat> {
+    size_t operator()(PackedBMat const& x) const noexcept {
+      return x.degree();
+    }
+  };
+
+  template <>
+  struct IncreaseDegree<PackedBMat> {
+    void operator()(PackedBMat&, size_t) const noexcept {}
+  };
+
+  template <>
+  struct One<PackedBMat> {
+    PackedBMat operator()(PackedBMat const& x) const {
+      return PackedBMat::identity(x.degree());
+    }
+
+    PackedBMat operator()(size_t n) const {
+      return PackedBMat::identity(n);
+    }
+  };
+
+  template <>
+  struct Product<PackedBMat> {
+    void operator()(PackedBMat&       xy,
+                    PackedBMat const& x,
+                    PackedBMat const& y,
+                    size_t = 0) const noexcept {
+      xy.product_inplace(x, y);
+    }
+  };
+}  // namespace libsemigroups
+
+namespace std {
+  template <>
+  struct hash<libsemigroups::PackedBMat> {
+    size_t operator()(libsemigroups::PackedBMat const& x) const noexcept {
+      return x.hash_value();
+    }
+  };
+}  // namespace std
+
+#endif  // SRC_PACKED_BMAT_HPP_
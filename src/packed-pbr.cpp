@@ -0,0 +1,218 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <string>
+#include <vector>
+
+#include <pybind11/chrono.h>
+#include <pybind11/functional.h>
+#include <pybind11/operators.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <libsemigroups/libsemigroups.hpp>
+
+#include "main.hpp"
+#include "packed-pbr.hpp"
+
+namespace py = pybind11;
+
+namespace libsemigroups {
+  namespace {
+    void validate_point(PackedPBR const &x, size_t i) {
+      if (i >= 2 * x.degree()) {
+        LIBSEMIGROUPS_EXCEPTION("expected a point less than %llu, found %llu",
+                                static_cast<uint64_t>(2 * x.degree()),
+                                static_cast<uint64_t>(i));
+      }
+    }
+
+    void validate_degrees(PackedPBR const &x, PackedPBR const &y) {
+      if (x.degree() != y.degree()) {
+        LIBSEMIGROUPS_EXCEPTION("expected PBRs of equal degree, found "
+                                "%llu and %llu",
+                                static_cast<uint64_t>(x.degree()),
+                                static_cast<uint64_t>(y.degree()));
+      }
+    }
+  }  // namespace
+
+  void init_packed_pbr(py::module &m) {
+    py::class_<PackedPBR>(m,
+                          "PackedPBR",
+                          R"pbdoc(
+      Class for partitioned binary relations of degree at most 32, where the
+      points adjacent to each point are packed into a single 64-bit block.
+      The product of two such PBRs does not allocate any memory, and so is
+      much faster than the product of two :py:class:`PBR` objects.
+    )pbdoc")
+        .def(py::init<size_t>(),
+             py::arg("n"),
+             R"pbdoc(
+               Constructs the PBR of degree ``n`` without any edges.
+
+               :param n: the degree.
+               :type n: int
+
+               :raises RuntimeError: if ``n`` is greater than ``32``.
+             )pbdoc")
+        .def(py::init<PackedPBR const &>())
+        .def(py::init<std::vector<std::vector<uint32_t>> const &>(),
+             py::arg("adj"),
+             R"pbdoc(
+               Constructs a PBR from the list of adjacencies of its points,
+               as in :py:meth:`PBR.make`.
+
+               :param adj: the list of adjacencies.
+               :type adj: List[List[int]]
+
+               :raises RuntimeError:
+                 if ``adj`` does not have even length at most ``64``, or it
+                 contains a point out of bounds.
+             )pbdoc")
+        .def(py::init<PBR const &>(),
+             py::arg("x"),
+             R"pbdoc(
+               Constructs a PBR equal to the :py:class:`PBR` ``x``.
+
+               :param x: the PBR.
+               :type x: PBR
+
+               :raises RuntimeError:
+                 if the degree of ``x`` is greater than ``32``.
+             )pbdoc")
+        .def(py::self == py::self)
+        .def(py::self != py::self)
+        .def(py::self < py::self)
+        .def("__hash__", &PackedPBR::hash_value)
+        .def(
+            "__mul__",
+            [](PackedPBR const &x, PackedPBR const &y) {
+              validate_degrees(x, y);
+              return x * y;
+            },
+            py::is_operator())
+        .def(
+            "product_inplace",
+            [](PackedPBR &xy, PackedPBR const &x, PackedPBR const &y) {
+              validate_degrees(x, y);
+              validate_degrees(xy, x);
+              if (&xy == &x || &xy == &y) {
+                LIBSEMIGROUPS_EXCEPTION(
+                    "cannot compute the product in place of one of its "
+                    "arguments");
+              }
+              xy.product_inplace(x, y);
+            },
+            py::arg("x"),
+            py::arg("y"),
+            R"pbdoc(
+              Sets ``self`` to the product of ``x`` and ``y``, without
+              allocating any memory.
+
+              :param x: the left-hand factor.
+              :type x: PackedPBR
+              :param y: the right-hand factor.
+              :type y: PackedPBR
+
+              :return: (None)
+
+              :raises RuntimeError:
+                if ``x``, ``y`` and ``self`` do not have equal degrees, or
+                ``self`` is ``x`` or ``y``.
+            )pbdoc")
+        .def(
+            "__getitem__",
+            [](PackedPBR const &x, size_t i) {
+              validate_point(x, i);
+              return x.adjacent(i);
+            },
+            py::arg("i"),
+            py::is_operator(),
+            R"pbdoc(
+              Returns the points adjacent to the point ``i``, in increasing
+              order.
+
+              :param i: the point.
+              :type i: int
+
+              :return: A ``List[int]``.
+
+              :raises RuntimeError: if ``i`` is out of bounds.
+            )pbdoc")
+        .def("degree",
+             &PackedPBR::degree,
+             R"pbdoc(
+               Returns the degree of ``self``.
+
+               :Parameters: None
+               :return: An ``int``.
+             )pbdoc")
+        .def("adjacencies",
+             &PackedPBR::adjacencies,
+             R"pbdoc(
+               Returns the list of adjacencies of the points of ``self``.
+
+               :Parameters: None
+               :return: A ``List[List[int]]``.
+             )pbdoc")
+        .def("to_pbr",
+             &PackedPBR::to_pbr,
+             R"pbdoc(
+               Returns the :py:class:`PBR` equal to ``self``.
+
+               :Parameters: None
+               :return: A :py:class:`PBR`.
+             )pbdoc")
+        .def(
+            "one",
+            [](PackedPBR const &x) { return PackedPBR::identity(x.degree()); },
+            R"pbdoc(
+              Returns the identity PBR with the same degree as ``self``.
+
+              :Parameters: None
+              :return: A :py:class:`PackedPBR`.
+            )pbdoc")
+        .def_static("identity",
+                    &PackedPBR::identity,
+                    py::arg("n"),
+                    R"pbdoc(
+                      Returns the identity PBR of degree ``n``.
+
+                      :param n: the degree.
+                      :type n: int
+
+                      :return: A :py:class:`PackedPBR`.
+
+                      :raises RuntimeError: if ``n`` is greater than ``32``.
+                    )pbdoc")
+        .def("__repr__", [](PackedPBR const &x) {
+          std::string result = "PackedPBR([";
+          for (size_t i = 0; i < 2 * x.degree(); ++i) {
+            result += (i == 0 ? "[" : ", [");
+            auto const adj = x.adjacent(i);
+            for (size_t j = 0; j < adj.size(); ++j) {
+              result += (j == 0 ? "" : ", ");
+              result += detail::to_string(adj[j]);
+            }
+            result += "]";
+          }
+          return result + "])";
+        });
+  }
+}  // namespace libsemigroups
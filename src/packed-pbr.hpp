@@ -0,0 +1,315 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the declaration of the class PackedPBR, which is a
+// partitioned binary relation of degree at most 32, where the points adjacent
+// to each point are packed into a single 64-bit block, and the adapters
+// required to use it as the element type of a FroidurePin.
+
+#ifndef SRC_PACKED_PBR_HPP_
+#define SRC_PACKED_PBR_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <libsemigroups/libsemigroups.hpp>
+
+#include "pool.hpp"
+
+namespace libsemigroups {
+
+  class PackedPBR {
+   public:
+    using block_type = uint64_t;
+
+    static constexpr size_t max_degree = 32;
+
+    PackedPBR() : PackedPBR(0) {}
+
+    // Constructs the PBR of degree n without any edges.
+    explicit PackedPBR(size_t n) : _n(n), _rows() {
+      if (n > max_degree) {
+        LIBSEMIGROUPS_EXCEPTION("expected degree at most %llu, found %llu",
+                                static_cast<uint64_t>(max_degree),
+                                static_cast<uint64_t>(n));
+      }
+    }
+
+    // Constructs the PBR where adj[i] is the list of points adjacent to the
+    // point i, as in PBR::make.
+    explicit PackedPBR(std::vector<std::vector<uint32_t>> const& adj)
+        : PackedPBR(adj.size() / 2) {
+      if (adj.size() % 2 != 0) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "expected an even number of adjacencies, found %llu",
+            static_cast<uint64_t>(adj.size()));
+      }
+      for (size_t i = 0; i < adj.size(); ++i) {
+        for (auto j : adj[i]) {
+          if (j >= adj.size()) {
+            LIBSEMIGROUPS_EXCEPTION(
+                "expected points less than %llu, found %llu adjacent to %llu",
+                static_cast<uint64_t>(adj.size()),
+                static_cast<uint64_t>(j),
+                static_cast<uint64_t>(i));
+          }
+          set(i, j, true);
+        }
+      }
+    }
+
+    explicit PackedPBR(PBR const& x) : PackedPBR(x.degree()) {
+      for (size_t i = 0; i < 2 * _n; ++i) {
+        for (auto j : x[i]) {
+          set(i, j, true);
+        }
+      }
+    }
+
+    PackedPBR(PackedPBR const&) = default;
+    PackedPBR(PackedPBR&&)      = default;
+    PackedPBR& operator=(PackedPBR const&) = default;
+    PackedPBR& operator=(PackedPBR&&) = default;
+
+    // The objects allocated with new, such as the elements stored in a
+    // FroidurePin, are allocated from a pool, see pool.hpp.
+    static void* operator new(size_t size) {
+      return detail::Pool<PackedPBR>::allocate(size);
+    }
+
+    static void operator delete(void* ptr, size_t size) noexcept {
+      detail::Pool<PackedPBR>::deallocate(ptr, size);
+    }
+
+    static PackedPBR identity(size_t n) {
+      PackedPBR result(n);
+      for (size_t i = 0; i < n; ++i) {
+        result.set(i, n + i, true);
+        result.set(n + i, i, true);
+      }
+      return result;
+    }
+
+    size_t degree() const noexcept {
+      return _n;
+    }
+
+    bool get(size_t i, size_t j) const noexcept {
+      return (_rows[i] >> j) & 1;
+    }
+
+    void set(size_t i, size_t j, bool val) noexcept {
+      block_type mask = block_type(1) << j;
+      if (val) {
+        _rows[i] |= mask;
+      } else {
+        _rows[i] &= ~mask;
+      }
+    }
+
+    // Sets this to x * y. The points 0, ..., n - 1 of y are identified with
+    // the points n, ..., 2n - 1 of x, and there is an edge from i to j in the
+    // product if there is a path from i to j alternating between edges of x
+    // and y, whose inner points are all identified points. The paths through
+    // the identified points are found by computing the transitive closure of
+    // a graph with at most 64 nodes, one block per node, and so the product
+    // does not allocate any memory. This must not be x or y.
+    void product_inplace(PackedPBR const& x, PackedPBR const& y) noexcept {
+      size_t const     n  = _n;
+      block_type const lo = (block_type(1) << n) - 1;
+
+      // The node s < n is the identified point s reached by an edge of x,
+      // which must be followed by an edge of y, and the node n + s is the
+      // identified point s reached by an edge of y, which must be followed
+      // by an edge of x. The non-identified points adjacent to the node s
+      // are out[s].
+      std::array<block_type, 2 * max_degree> reach, out;
+      for (size_t s = 0; s < n; ++s) {
+        reach[s]     = (y._rows[s] & lo) << n;
+        out[s]       = y._rows[s] & ~lo;
+        reach[n + s] = x._rows[n + s] >> n;
+        out[n + s]   = x._rows[n + s] & lo;
+      }
+      for (size_t k = 0; k < 2 * n; ++k) {
+        for (size_t s = 0; s < 2 * n; ++s) {
+          if ((reach[s] >> k) & 1) {
+            reach[s] |= reach[k];
+          }
+        }
+      }
+      for (size_t s = 0; s < 2 * n; ++s) {
+        block_type w = reach[s];
+        while (w != 0) {
+          out[s] |= out[trailing_zeros(w)];
+          w &= w - 1;
+        }
+      }
+      for (size_t i = 0; i < n; ++i) {
+        _rows[i]     = (x._rows[i] & lo) | union_of(out, x._rows[i] >> n);
+        _rows[n + i] = (y._rows[n + i] & ~lo)
+                       | union_of(out, (y._rows[n + i] & lo) << n);
+      }
+    }
+
+    PackedPBR operator*(PackedPBR const& y) const {
+      PackedPBR result(_n);
+      result.product_inplace(*this, y);
+      return result;
+    }
+
+    bool operator==(PackedPBR const& that) const noexcept {
+      return _n == that._n
+             && std::equal(_rows.cbegin(),
+                           _rows.cbegin() + 2 * _n,
+                           that._rows.cbegin());
+    }
+
+    bool operator!=(PackedPBR const& that) const noexcept {
+      return !(*this == that);
+    }
+
+    bool operator<(PackedPBR const& that) const noexcept {
+      return _n < that._n
+             || (_n == that._n
+                 && std::lexicographical_compare(_rows.cbegin(),
+                                                 _rows.cbegin() + 2 * _n,
+                                                 that._rows.cbegin(),
+                                                 that._rows.cbegin() + 2 * _n));
+    }
+
+    size_t hash_value() const noexcept {
+      size_t seed = _n;
+      for (size_t i = 0; i < 2 * _n; ++i) {
+        seed ^= std::hash<block_type>()(_rows[i]) + 0x9e3779b97f4a7c16
+                + (seed << 6) + (seed >> 2);
+      }
+      return seed;
+    }
+
+    // Returns the points adjacent to the point i, in increasing order.
+    std::vector<uint32_t> adjacent(size_t i) const {
+      std::vector<uint32_t> result;
+      block_type            w = _rows[i];
+      while (w != 0) {
+        result.push_back(trailing_zeros(w));
+        w &= w - 1;
+      }
+      return result;
+    }
+
+    std::vector<std::vector<uint32_t>> adjacencies() const {
+      std::vector<std::vector<uint32_t>> result;
+      for (size_t i = 0; i < 2 * _n; ++i) {
+        result.push_back(adjacent(i));
+      }
+      return result;
+    }
+
+    PBR to_pbr() const {
+      return PBR::make(adjacencies());
+    }
+
+   private:
+    // Returns the union of the blocks out[s] for the bits s of w.
+    static block_type
+    union_of(std::array<block_type, 2 * max_degree> const& out,
+             block_type                                    w) noexcept {
+      block_type result = 0;
+      while (w != 0) {
+        result |= out[trailing_zeros(w)];
+        w &= w - 1;
+      }
+      return result;
+    }
+
+    static size_t trailing_zeros(block_type w) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_ctzll(w);
+#else
+      size_t result = 0;
+      while ((w & 1) == 0) {
+        w >>= 1;
+        ++result;
+      }
+      return result;
+#endif
+    }
+
+    size_t                                 _n;
+    std::array<block_type, 2 * max_degree> _rows;
+  };
+
+  ////////////////////////////////////////////////////////////////////////
+  // Adapters
+  ////////////////////////////////////////////////////////////////////////
+
+  template <>
+  struct Complexity<PackedPBR> {
+    size_t operator()(PackedPBR const& x) const noexcept {
+      return 4 * x.degree() * x.degree();
+    }
+  };
+
+  template <>
+  struct Degree<PackedPBR> {
+    size_t operator()(PackedPBR const& x) const noexcept {
+      return x.degree();
+    }
+  };
+
+  template <>
+  struct IncreaseDegree<PackedPBR> {
+    void operator()(PackedPBR&, size_t) const noexcept {}
+  };
+
+  template <>
+  struct One<PackedPBR> {
+    PackedPBR operator()(PackedPBR const& x) const {
+      return PackedPBR::identity(x.degree());
+    }
+
+    PackedPBR operator()(size_t n) const {
+      return PackedPBR::identity(n);
+    }
+  };
+
+  template <>
+  struct Product<PackedPBR> {
+    void operator()(PackedPBR&       xy,
+                    PackedPBR const& x,
+                    PackedPBR const& y,
+                    size_t = 0) const noexcept {
+      xy.product_inplace(x, y);
+    }
+  };
+}  // namespace libsemigroups
+
+namespace std {
+  template <>
+  struct hash<libsemigroups::PackedPBR> {
+    size_t operator()(libsemigroups::PackedPBR const& x) const noexcept {
+      return x.hash_value();
+    }
+  };
+}  // namespace std
+
+#endif  // SRC_PACKED_PBR_HPP_
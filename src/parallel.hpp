@@ -0,0 +1,58 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains helpers for the functions that split work over arrays
+// of elements across several threads.
+
+#ifndef SRC_PARALLEL_HPP_
+#define SRC_PARALLEL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace libsemigroups {
+  namespace detail {
+    // Calls f(first, last) for consecutive ranges [first, last) covering
+    // [0, n), in parallel using at most <number_of_threads> threads.
+    template <typename Func>
+    void parallel_for(size_t n, size_t number_of_threads, Func &&f) {
+      number_of_threads
+          = std::max(size_t(1), std::min(number_of_threads, n));
+      if (number_of_threads == 1) {
+        f(0, n);
+        return;
+      }
+      std::vector<std::thread> threads;
+      size_t const             q     = n / number_of_threads;
+      size_t const             r     = n % number_of_threads;
+      size_t                   first = 0;
+      for (size_t i = 0; i < number_of_threads; ++i) {
+        size_t last = first + q + (i < r ? 1 : 0);
+        threads.emplace_back(f, first, last);
+        first = last;
+      }
+      for (auto &t : threads) {
+        t.join();
+      }
+    }
+  }  // namespace detail
+}  // namespace libsemigroups
+
+#endif  // SRC_PARALLEL_HPP_
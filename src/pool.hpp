@@ -0,0 +1,165 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the declaration of the class template Pool, which
+// allocates objects of a fixed size type from large chunks of memory, rather
+// than one at a time, and is used by the class specific operator new and
+// operator delete of the packed element types. A FroidurePin stores every
+// element as a pointer to an object allocated with new, and so the elements
+// it stores are allocated contiguously, without the bookkeeping overhead of
+// the general purpose allocator.
+
+#ifndef SRC_POOL_HPP_
+#define SRC_POOL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+namespace libsemigroups {
+  namespace detail {
+    // Every thread has its own list of free slots, so that allocating and
+    // deallocating do not usually require any synchronisation. A slot may be
+    // freed by a thread other than the one that allocated it, and so, when
+    // the list of a thread is longer than max_local_slots, a chunk's worth of
+    // its slots are moved to a shared list, as are all of them when the
+    // thread exits. When the list of a thread is empty, it takes the slots in
+    // the shared list, or a new chunk of slots if there are none. So the
+    // slots freed by one thread are reused by the others, for example, if
+    // elements are created by one thread and freed by another. The chunks
+    // are never released.
+    template <typename T>
+    class Pool {
+      union Slot {
+        Slot* next;
+        alignas(T) unsigned char data[sizeof(T)];
+      };
+
+      static constexpr size_t chunk_bytes = size_t(1) << 16;
+      static constexpr size_t slots_per_chunk
+          = std::max(size_t(1), chunk_bytes / sizeof(Slot));
+      static constexpr size_t max_local_slots = 2 * slots_per_chunk;
+
+      // The slots given up by the threads.
+      struct Shared {
+        std::mutex mtx;
+        Slot*      head  = nullptr;
+        size_t     count = 0;
+      };
+
+      struct Local {
+        Slot*  head  = nullptr;
+        size_t count = 0;
+
+        ~Local() {
+          if (head != nullptr) {
+            give_up(*this, count);
+          }
+        }
+      };
+
+     public:
+      // Returns a pointer to uninitialised memory for an object of size
+      // <size>, which is only allocated from a chunk if <size> is sizeof(T),
+      // so that objects of types derived from T are allocated as usual.
+      static void* allocate(size_t size) {
+        if (size != sizeof(T)) {
+          return ::operator new(size);
+        }
+        Local& local = local_slots();
+        if (local.head == nullptr) {
+          refill(local);
+        }
+        Slot* result = local.head;
+        local.head   = result->next;
+        --local.count;
+        return result;
+      }
+
+      static void deallocate(void* ptr, size_t size) noexcept {
+        if (ptr == nullptr) {
+          return;
+        } else if (size != sizeof(T)) {
+          ::operator delete(ptr);
+          return;
+        }
+        Local& local = local_slots();
+        Slot*  slot  = static_cast<Slot*>(ptr);
+        slot->next   = local.head;
+        local.head   = slot;
+        if (++local.count > max_local_slots) {
+          give_up(local, slots_per_chunk);
+        }
+      }
+
+     private:
+      static Shared& shared_slots() {
+        // Never destroyed, since elements may still be freed during exit.
+        static Shared* shared = new Shared();
+        return *shared;
+      }
+
+      static Local& local_slots() {
+        static thread_local Local local;
+        return local;
+      }
+
+      // Moves the first n slots in the list of local, which must have at
+      // least n slots, to the shared list.
+      static void give_up(Local& local, size_t n) {
+        Slot* first = local.head;
+        Slot* last  = first;
+        for (size_t i = 1; i < n; ++i) {
+          last = last->next;
+        }
+        local.head = last->next;
+        local.count -= n;
+
+        Shared&                     shared = shared_slots();
+        std::lock_guard<std::mutex> lock(shared.mtx);
+        last->next = shared.head;
+        shared.head  = first;
+        shared.count += n;
+      }
+
+      static void refill(Local& local) {
+        {
+          Shared&                     shared = shared_slots();
+          std::lock_guard<std::mutex> lock(shared.mtx);
+          if (shared.head != nullptr) {
+            local.head   = shared.head;
+            local.count  = shared.count;
+            shared.head  = nullptr;
+            shared.count = 0;
+            return;
+          }
+        }
+        Slot* chunk = new Slot[slots_per_chunk];
+        for (size_t i = 0; i < slots_per_chunk - 1; ++i) {
+          chunk[i].next = &chunk[i + 1];
+        }
+        chunk[slots_per_chunk - 1].next = nullptr;
+        local.head                      = chunk;
+        local.count                     = slots_per_chunk;
+      }
+    };
+  }  // namespace detail
+}  // namespace libsemigroups
+
+#endif  // SRC_POOL_HPP_
@@ -0,0 +1,210 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <pybind11/chrono.h>
+#include <pybind11/functional.h>
+#include <pybind11/operators.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <libsemigroups/libsemigroups.hpp>
+
+#include "main.hpp"
+
+namespace py = pybind11;
+
+namespace libsemigroups {
+  void init_present(py::module &m) {
+    using Presentation_ = Presentation<word_type>;
+
+    py::class_<Presentation_>(m,
+                              "Presentation",
+                              R"pbdoc(
+      A :py:class:`Presentation` consists of an alphabet and a list of rules,
+      where the letters of the alphabet are non-negative integers, and each
+      rule is a pair of words (lists of letters) in the alphabet. A
+      :py:class:`Presentation` can be used to define the input to several of
+      the algorithms in ``libsemigroups_pybind11``, such as :py:class:`Sims1`.
+    )pbdoc")
+        .def(py::init<>(),
+             R"pbdoc(
+               Default constructor.
+
+               Constructs an empty presentation with no rules and no alphabet.
+             )pbdoc")
+        .def(py::init<Presentation_ const &>(),
+             py::arg("that"),
+             R"pbdoc(
+               Copy constructor.
+
+               :param that: the presentation to copy.
+               :type that: Presentation
+             )pbdoc")
+        .def("alphabet",
+             py::overload_cast<>(&Presentation_::alphabet, py::const_),
+             R"pbdoc(
+               Returns the alphabet of the presentation.
+
+               :Parameters: None
+               :return: A ``List[int]``.
+             )pbdoc")
+        .def("alphabet",
+             py::overload_cast<size_t>(&Presentation_::alphabet),
+             py::arg("n"),
+             py::return_value_policy::reference,
+             R"pbdoc(
+               Set the alphabet to ``[0, 1, ..., n - 1]``.
+
+               :param n: the size of the alphabet.
+               :type n: int
+
+               :return: ``self``.
+
+               :raises RuntimeError: if ``n`` is ``0``.
+             )pbdoc")
+        .def("alphabet",
+             py::overload_cast<word_type const &>(&Presentation_::alphabet),
+             py::arg("lphbt"),
+             py::return_value_policy::reference,
+             R"pbdoc(
+               Set the alphabet.
+
+               :param lphbt: the alphabet.
+               :type lphbt: List[int]
+
+               :return: ``self``.
+
+               :raises RuntimeError: if there are duplicate letters in ``lphbt``.
+             )pbdoc")
+        .def("alphabet_from_rules",
+             &Presentation_::alphabet_from_rules,
+             py::return_value_policy::reference,
+             R"pbdoc(
+               Set the alphabet to be the letters in the rules.
+
+               :Parameters: None
+               :return: ``self``.
+             )pbdoc")
+        .def("letter",
+             &Presentation_::letter,
+             py::arg("i"),
+             R"pbdoc(
+               Returns the letter in the alphabet with index ``i``.
+
+               :param i: the index.
+               :type i: int
+
+               :return: An ``int``.
+             )pbdoc")
+        .def("index",
+             &Presentation_::index,
+             py::arg("val"),
+             R"pbdoc(
+               Returns the index of a letter in the alphabet.
+
+               :param val: the letter.
+               :type val: int
+
+               :return: An ``int``.
+             )pbdoc")
+        .def("contains_empty_word",
+             py::overload_cast<>(&Presentation_::contains_empty_word,
+                                 py::const_),
+             R"pbdoc(
+               Check if the presentation should contain the empty word, i.e.
+               if it is a monoid presentation.
+
+               :Parameters: None
+               :return: A ``bool``.
+             )pbdoc")
+        .def("contains_empty_word",
+             py::overload_cast<bool>(&Presentation_::contains_empty_word),
+             py::arg("val"),
+             py::return_value_policy::reference,
+             R"pbdoc(
+               Set whether or not the presentation can contain the empty word.
+
+               :param val: whether or not the empty word is allowed.
+               :type val: bool
+
+               :return: ``self``.
+             )pbdoc")
+        .def_readwrite("rules",
+                       &Presentation_::rules,
+                       R"pbdoc(
+                         The rules of the presentation, rule ``i`` consisting
+                         of ``rules[2 * i]`` and ``rules[2 * i + 1]``.
+                       )pbdoc")
+        .def(
+            "add_rule",
+            [](Presentation_ &p, word_type const &lhs, word_type const &rhs) {
+              presentation::add_rule(p, lhs, rhs);
+            },
+            py::arg("lhs"),
+            py::arg("rhs"),
+            R"pbdoc(
+              Add a rule.
+
+              :param lhs: the left-hand side of the rule.
+              :type lhs: List[int]
+              :param rhs: the right-hand side of the rule.
+              :type rhs: List[int]
+
+              :return: (None)
+            )pbdoc")
+        .def(
+            "add_rule_and_check",
+            [](Presentation_ &p, word_type const &lhs, word_type const &rhs) {
+              presentation::add_rule_and_check(p, lhs, rhs);
+            },
+            py::arg("lhs"),
+            py::arg("rhs"),
+            R"pbdoc(
+              Add a rule, and check that its letters belong to the alphabet.
+
+              :param lhs: the left-hand side of the rule.
+              :type lhs: List[int]
+              :param rhs: the right-hand side of the rule.
+              :type rhs: List[int]
+
+              :return: (None)
+
+              :raises RuntimeError:
+                if ``lhs`` or ``rhs`` contains a letter not in the alphabet.
+            )pbdoc")
+        .def("validate",
+             &Presentation_::validate,
+             R"pbdoc(
+               Check if the alphabet and rules are valid.
+
+               :Parameters: None
+               :return: (None)
+
+               :raises RuntimeError:
+                 if the alphabet contains duplicates, a rule contains a letter
+                 not in the alphabet, there are an odd number of words in
+                 :py:attr:`rules`, or the empty word appears in a rule but
+                 :py:meth:`contains_empty_word` is ``False``.
+             )pbdoc")
+        .def("__repr__", [](Presentation_ const &p) {
+          return std::string("<presentation with ")
+                 + detail::to_string(p.alphabet().size()) + " letters and "
+                 + detail::to_string(p.rules.size() / 2) + " rules>";
+        });
+  }
+}  // namespace libsemigroups
@@ -0,0 +1,308 @@
+//
+// libsemigroups_pybind11
+// Copyright (C) 2021 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <exception>
+
+#include <pybind11/chrono.h>
+#include <pybind11/functional.h>
+#include <pybind11/operators.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <libsemigroups/libsemigroups.hpp>
+
+#include "main.hpp"
+
+namespace py = pybind11;
+
+namespace libsemigroups {
+  namespace {
+    // Wraps a Python function called on the digraphs found by a Sims1
+    // search. If the number of threads is greater than 1, then the function
+    // is called from threads that belong to libsemigroups, and an exception
+    // escaping one of these threads terminates the interpreter. So the first
+    // exception raised by the function is stored, the search is stopped, and
+    // the exception is rethrown by rethrow_if_raised once the search is over.
+    class Sims1Hook {
+     public:
+      Sims1Hook(py::function const &f, bool is_pred)
+          : _f(f), _is_pred(is_pred), _error() {}
+
+      // Returns true if the search should stop, because the function raised
+      // an exception, or is a predicate and returned True.
+      bool operator()(ActionDigraph<size_t> const &d) {
+        py::gil_scoped_acquire acquire;
+        if (_error != nullptr) {
+          return true;
+        }
+        try {
+          py::object result = _f(d);
+          return _is_pred && result.cast<bool>();
+        } catch (...) {
+          _error = std::current_exception();
+          return true;
+        }
+      }
+
+      void rethrow_if_raised() const {
+        if (_error != nullptr) {
+          std::rethrow_exception(_error);
+        }
+      }
+
+     private:
+      py::function       _f;
+      bool               _is_pred;
+      std::exception_ptr _error;
+    };
+  }  // namespace
+
+  void init_sims1(py::module &m) {
+    // We use size_t as the node type so that the digraphs produced are of the
+    // same type as the ActionDigraph class bound in action-digraph.cpp.
+    using Sims1_ = Sims1<size_t>;
+
+    py::class_<Sims1_>(m,
+                       "Sims1",
+                       R"pbdoc(
+      This class can be used to determine the left or right congruences of a
+      finitely presented semigroup or monoid with at most a given number of
+      classes, using the low-index congruences algorithm (a variant of Sims'
+      low-index subgroups algorithm).
+
+      The congruences are represented by :py:class:`ActionDigraph` instances,
+      the nodes of which are the congruence classes, and where node ``0`` is
+      the class of the empty word (for monoids), or an additional node (for
+      semigroups).
+    )pbdoc")
+        .def(py::init<congruence_kind>(),
+             py::arg("kind"),
+             R"pbdoc(
+               Construct from the kind of congruence (left or right).
+
+               :param kind: the handedness of the congruences.
+               :type kind: congruence_kind
+
+               :raises RuntimeError: if ``kind`` is ``congruence_kind.twosided``.
+             )pbdoc")
+        .def(
+            "short_rules",
+            [](Sims1_ &S, Presentation<word_type> const &p) -> Sims1_ & {
+              return S.short_rules(p);
+            },
+            py::arg("p"),
+            py::return_value_policy::reference,
+            R"pbdoc(
+              Set the short rules, these are the rules used at every node in
+              the search tree. Typically these are the defining relations of
+              the semigroup or monoid.
+
+              :param p: the presentation.
+              :type p: Presentation
+
+              :return: ``self``.
+            )pbdoc")
+        .def(
+            "short_rules",
+            [](Sims1_ const &S) { return S.short_rules(); },
+            R"pbdoc(
+              Returns a copy of the presentation of the short rules.
+
+              :Parameters: None
+              :return: A :py:class:`Presentation`.
+            )pbdoc")
+        .def(
+            "long_rules",
+            [](Sims1_ &S, Presentation<word_type> const &p) -> Sims1_ & {
+              return S.long_rules(p);
+            },
+            py::arg("p"),
+            py::return_value_policy::reference,
+            R"pbdoc(
+              Set the long rules, these are the rules used only once a
+              complete digraph has been found, to check if it is compatible
+              with them.
+
+              :param p: the presentation.
+              :type p: Presentation
+
+              :return: ``self``.
+            )pbdoc")
+        .def(
+            "long_rules",
+            [](Sims1_ const &S) { return S.long_rules(); },
+            R"pbdoc(
+              Returns a copy of the presentation of the long rules.
+
+              :Parameters: None
+              :return: A :py:class:`Presentation`.
+            )pbdoc")
+        .def(
+            "extra",
+            [](Sims1_ &S, Presentation<word_type> const &p) -> Sims1_ & {
+              return S.extra(p);
+            },
+            py::arg("p"),
+            py::return_value_policy::reference,
+            R"pbdoc(
+              Set the extra rules, these are pairs that must belong to every
+              congruence found.
+
+              :param p: the presentation.
+              :type p: Presentation
+
+              :return: ``self``.
+            )pbdoc")
+        .def(
+            "extra",
+            [](Sims1_ const &S) { return S.extra(); },
+            R"pbdoc(
+              Returns a copy of the presentation of the extra rules.
+
+              :Parameters: None
+              :return: A :py:class:`Presentation`.
+            )pbdoc")
+        .def(
+            "number_of_threads",
+            [](Sims1_ &S, size_t val) -> Sims1_ & {
+              return S.number_of_threads(val);
+            },
+            py::arg("val"),
+            py::return_value_policy::reference,
+            R"pbdoc(
+              Set the number of threads used by :py:meth:`number_of_congruences`,
+              :py:meth:`for_each`, and :py:meth:`find_if`.
+
+              :param val: the number of threads.
+              :type val: int
+
+              :return: ``self``.
+            )pbdoc")
+        .def(
+            "number_of_threads",
+            [](Sims1_ const &S) { return S.number_of_threads(); },
+            R"pbdoc(
+              Returns the number of threads.
+
+              :Parameters: None
+              :return: An ``int``.
+            )pbdoc")
+        .def("number_of_congruences",
+             &Sims1_::number_of_congruences,
+             py::arg("n"),
+             py::call_guard<py::gil_scoped_release>(),
+             R"pbdoc(
+               Returns the number of one-sided congruences with at most ``n``
+               classes. No digraphs are returned to Python, and if
+               :py:meth:`number_of_threads` is greater than ``1``, then the
+               search is run in parallel.
+
+               :param n: the maximum number of classes.
+               :type n: int
+
+               :return: An ``int``.
+
+               :raises RuntimeError: if ``n`` is ``0``, or if
+                 :py:meth:`short_rules` has ``0`` generators.
+             )pbdoc")
+        .def(
+            "for_each",
+            [](Sims1_ const &S, size_t n, py::function const &hook) {
+              Sims1Hook f(hook, false);
+              {
+                py::gil_scoped_release release;
+                S.find_if(n, [&f](ActionDigraph<size_t> const &d) {
+                  return f(d);
+                });
+              }
+              f.rethrow_if_raised();
+            },
+            py::arg("n"),
+            py::arg("hook"),
+            R"pbdoc(
+               Apply a function to every one-sided congruence with at most
+               ``n`` classes.
+
+               If :py:meth:`number_of_threads` is greater than ``1``, then
+               ``hook`` is called from several threads, each of which acquires
+               the GIL for the duration of the call. If ``hook`` raises an
+               exception, then the search is stopped, and the exception is
+               raised by this function.
+
+               :param n: the maximum number of classes.
+               :type n: int
+               :param hook: the function to apply.
+               :type hook: Callable[[ActionDigraph], None]
+
+               :return: (None)
+             )pbdoc")
+        .def(
+            "find_if",
+            [](Sims1_ const &S, size_t n, py::function const &pred) {
+              Sims1Hook             f(pred, true);
+              ActionDigraph<size_t> result;
+              {
+                py::gil_scoped_release release;
+                result = S.find_if(n, [&f](ActionDigraph<size_t> const &d) {
+                  return f(d);
+                });
+              }
+              f.rethrow_if_raised();
+              return result;
+            },
+            py::arg("n"),
+            py::arg("pred"),
+            R"pbdoc(
+              Returns the first digraph found for which ``pred`` returns
+              ``True``, or an empty digraph if there is no such digraph. If
+              ``pred`` raises an exception, then the search is stopped, and
+              the exception is raised by this function.
+
+              :param n: the maximum number of classes.
+              :type n: int
+              :param pred: the predicate.
+              :type pred: Callable[[ActionDigraph], bool]
+
+              :return: An :py:class:`ActionDigraph`.
+            )pbdoc")
+        .def(
+            "iterator",
+            [](Sims1_ const &S, size_t n) {
+              return py::make_iterator<py::return_value_policy::copy>(
+                  S.cbegin(n), S.cend(n));
+            },
+            py::arg("n"),
+            py::keep_alive<0, 1>(),
+            R"pbdoc(
+              Returns an iterator yielding the one-sided congruences with at
+              most ``n`` classes, in the order they are found. The congruences
+              are computed lazily, one at a time, and this function is not
+              multithreaded.
+
+              :param n: the maximum number of classes.
+              :type n: int
+
+              :return: An iterator of :py:class:`ActionDigraph`.
+            )pbdoc")
+        .def("__repr__", [](Sims1_ const &S) {
+          return std::string("<Sims1 object with ")
+                 + detail::to_string(S.short_rules().rules.size() / 2)
+                 + " short rules>";
+        });
+  }
+}  // namespace libsemigroups
@@ -16,8 +16,26 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__i386__))
+#define SRC_TRANSF_SSSE3
+#include <tmmintrin.h>
+#endif
+
 #include <pybind11/chrono.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -25,6 +43,7 @@
 #include <libsemigroups/libsemigroups.hpp>
 
 #include "main.hpp"
+#include "parallel.hpp"
 
 namespace py = pybind11;
 
@@ -64,6 +83,7 @@ namespace libsemigroups {
           .def(pybind11::self == pybind11::self)
           .def(pybind11::self < pybind11::self)
           .def(py::self * py::self)
+          .def("__hash__", [](T const &x) { return Hash<T>()(x); })
           .def("degree", [](T const &x) { return x.degree(); })
           .def("images",
                [](T const &x) {
@@ -77,14 +97,15 @@ namespace libsemigroups {
     }
 
     template <typename T>
-    void bind_transf(py::module &m, char const *name) {
+    py::class_<T> bind_transf(py::module &m, char const *name) {
       py::class_<T> x(m, name);
       bind_ptransf<T>(x);
       x.def("__repr__", [](T const &x) { return transf_repr(x); });
+      return x;
     }
 
     template <typename T>
-    void bind_pperm(py::module &m, char const *name) {
+    py::class_<T> bind_pperm(py::module &m, char const *name) {
       using value_type = typename T::value_type;
       py::class_<T> x(m, name);
       bind_ptransf<T>(x);
@@ -98,33 +119,717 @@ namespace libsemigroups {
           .def("inverse", py::overload_cast<>(&T::inverse, py::const_))
           .def("inverse", py::overload_cast<T &>(&T::inverse, py::const_))
           .def("undef", &T::undef);
+      return x;
     }
 
     template <typename T, typename S>
-    void bind_perm(py::module &m, char const *name) {
+    py::class_<T, S> bind_perm(py::module &m, char const *name) {
       py::class_<T, S> x(m, name);
       bind_ptransf<T>(x);
       x.def("inverse", &T::inverse);
+      return x;
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // Functions for arrays of Transf16, PPerm16, and Perm16
+    ////////////////////////////////////////////////////////////////////////
+
+    // An element of degree 16 is stored in a row of 16 bytes, where the
+    // undefined points of a partial perm are 255.
+    using uint8_array
+        = py::array_t<uint8_t, py::array::c_style | py::array::forcecast>;
+
+    enum class kind16 { transf, pperm, perm };
+
+    constexpr uint8_t undef16 = 0xFF;
+
+    bool is_valid16(uint8_t const *x, kind16 kind) {
+      uint32_t seen = 0;
+      for (size_t i = 0; i < 16; ++i) {
+        if (x[i] == undef16 && kind == kind16::pperm) {
+          continue;
+        } else if (x[i] >= 16) {
+          return false;
+        } else if (kind != kind16::transf && (seen >> x[i]) & 1) {
+          return false;
+        }
+        seen |= uint32_t(1) << x[i];
+      }
+      return true;
+    }
+
+    size_t rank16(uint8_t const *x) {
+      uint32_t seen = 0;
+      for (size_t i = 0; i < 16; ++i) {
+        if (x[i] != undef16) {
+          seen |= uint32_t(1) << x[i];
+        }
+      }
+      return std::bitset<16>(seen).count();
+    }
+
+    void inverse16(uint8_t const *x, uint8_t *out) {
+      std::fill(out, out + 16, undef16);
+      for (size_t i = 0; i < 16; ++i) {
+        if (x[i] != undef16) {
+          out[x[i] & 15] = i;
+        }
+      }
+    }
+
+    // Sets out[k] to the product xs[k] * ys[k] for every k in [first, last),
+    // where the image of i under x * y is y[x[i]]. The elements are not
+    // validated, but the images are read modulo 16, and so invalid elements
+    // do not result in out of bounds accesses.
+    void products16(uint8_t const *xs,
+                    uint8_t const *ys,
+                    uint8_t *      out,
+                    size_t         first,
+                    size_t         last,
+                    kind16         kind) {
+      for (size_t k = 16 * first; k < 16 * last; k += 16) {
+        for (size_t i = 0; i < 16; ++i) {
+          uint8_t const xi = xs[k + i];
+          out[k + i] = (xi == undef16 && kind == kind16::pperm)
+                           ? undef16
+                           : ys[k + (xi & 15)];
+        }
+      }
+    }
+
+#ifdef SRC_TRANSF_SSSE3
+    // As above, but every product is a single byte shuffle of y by x. If
+    // the byte x[i] has its high bit set, then the shuffle sets the ith byte
+    // of the product to 0, and so the undefined points of a partial perm are
+    // restored afterwards.
+    __attribute__((target("ssse3"))) void
+    products16_ssse3(uint8_t const *xs,
+                     uint8_t const *ys,
+                     uint8_t *      out,
+                     size_t         first,
+                     size_t         last,
+                     kind16         kind) {
+      __m128i const mask  = _mm_set1_epi8(static_cast<char>(0x8F));
+      __m128i const undef = _mm_set1_epi8(static_cast<char>(undef16));
+      for (size_t k = 16 * first; k < 16 * last; k += 16) {
+        __m128i const x
+            = _mm_loadu_si128(reinterpret_cast<__m128i const *>(xs + k));
+        __m128i const y
+            = _mm_loadu_si128(reinterpret_cast<__m128i const *>(ys + k));
+        __m128i xy = _mm_shuffle_epi8(y, _mm_and_si128(x, mask));
+        if (kind == kind16::pperm) {
+          xy = _mm_or_si128(xy, _mm_cmpeq_epi8(x, undef));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + k), xy);
+      }
+    }
+
+    bool has_ssse3() {
+      static bool const result = __builtin_cpu_supports("ssse3");
+      return result;
+    }
+#endif
+
+    void validate_shape16(uint8_array const &xs) {
+      if (xs.ndim() != 2 || xs.shape(1) != 16) {
+        LIBSEMIGROUPS_EXCEPTION(
+            "expected an array of shape (N, 16), found an array of shape %s",
+            py::str(xs.attr("shape")).cast<std::string>().c_str());
+      }
+    }
+
+    // Throws if <xs> does not have shape (N, 16), or if any of its rows is not
+    // a valid element. The rows are validated in parallel, and the first
+    // invalid row, if any, is found afterwards.
+    void validate16(uint8_array const &xs,
+                    kind16             kind,
+                    size_t             number_of_threads) {
+      validate_shape16(xs);
+      size_t const      n    = xs.shape(0);
+      uint8_t const *   data = xs.data();
+      std::atomic<bool> ok(true);
+      {
+        py::gil_scoped_release release;
+        detail::parallel_for(
+            n, number_of_threads, [data, kind, &ok](size_t first, size_t last) {
+              for (size_t k = first; k < last && ok; ++k) {
+                if (!is_valid16(data + 16 * k, kind)) {
+                  ok = false;
+                }
+              }
+            });
+      }
+      if (ok) {
+        return;
+      }
+      for (size_t k = 0; k < n; ++k) {
+        if (!is_valid16(data + 16 * k, kind)) {
+          LIBSEMIGROUPS_EXCEPTION("the element in position %llu is invalid",
+                                  static_cast<uint64_t>(k));
+        }
+      }
+    }
+
+    template <typename S>
+    void bind_batch16(S &x, kind16 kind) {
+      char const *products_doc = R"pbdoc(
+        Returns the products ``xs[k] * ys[k]`` of the elements in the arrays
+        ``xs`` and ``ys``, of shape ``(N, 16)`` and dtype ``uint8``, where
+        every row contains the images of an element of degree ``16``, and
+        ``255`` denotes an undefined image of a partial perm. The products are
+        computed using a single byte shuffle each, if the processor supports
+        it, and no Python objects are created for the individual elements.
+
+        :param xs: the left-hand factors.
+        :type xs: numpy.ndarray
+        :param ys: the right-hand factors.
+        :type ys: numpy.ndarray
+        :param number_of_threads: the number of threads (default: ``1``).
+        :type number_of_threads: int
+
+        :return: A ``numpy.ndarray`` of shape ``(N, 16)`` and dtype ``uint8``.
+
+        :raises RuntimeError:
+          if ``xs`` and ``ys`` do not have the same shape ``(N, 16)``, or if
+          any of their rows is not a valid element.
+      )pbdoc";
+
+      x.def_static(
+          "products",
+          [kind](uint8_array const &xs,
+                 uint8_array const &ys,
+                 size_t             number_of_threads) {
+            validate16(xs, kind, number_of_threads);
+            validate16(ys, kind, number_of_threads);
+            if (xs.shape(0) != ys.shape(0)) {
+              LIBSEMIGROUPS_EXCEPTION(
+                  "expected arrays with equal numbers of rows, found %llu "
+                  "and %llu",
+                  static_cast<uint64_t>(xs.shape(0)),
+                  static_cast<uint64_t>(ys.shape(0)));
+            }
+            uint8_array    result({xs.shape(0), py::ssize_t(16)});
+            uint8_t const *xp  = xs.data();
+            uint8_t const *yp  = ys.data();
+            uint8_t *      out = result.mutable_data();
+            auto           f   = &products16;
+#ifdef SRC_TRANSF_SSSE3
+            if (has_ssse3()) {
+              f = &products16_ssse3;
+            }
+#endif
+            py::gil_scoped_release release;
+            detail::parallel_for(
+                xs.shape(0),
+                number_of_threads,
+                [xp, yp, out, f, kind](size_t first, size_t last) {
+                  f(xp, yp, out, first, last, kind);
+                });
+            return result;
+          },
+          py::arg("xs"),
+          py::arg("ys"),
+          py::arg("number_of_threads") = 1,
+          products_doc);
+
+      x.def_static(
+          "ranks",
+          [kind](uint8_array const &xs, size_t number_of_threads) {
+            validate16(xs, kind, number_of_threads);
+            py::array_t<uint64_t> result(xs.shape(0));
+            uint8_t const *       xp  = xs.data();
+            uint64_t *            out = result.mutable_data();
+            py::gil_scoped_release release;
+            detail::parallel_for(xs.shape(0),
+                                 number_of_threads,
+                                 [xp, out](size_t first, size_t last) {
+                                   for (size_t k = first; k < last; ++k) {
+                                     out[k] = rank16(xp + 16 * k);
+                                   }
+                                 });
+            return result;
+          },
+          py::arg("xs"),
+          py::arg("number_of_threads") = 1,
+          R"pbdoc(
+            Returns the ranks of the elements in the array ``xs``, see
+            :py:meth:`products`.
+
+            :param xs: the elements.
+            :type xs: numpy.ndarray
+            :param number_of_threads: the number of threads (default: ``1``).
+            :type number_of_threads: int
+
+            :return: A ``numpy.ndarray`` of length ``N`` and dtype ``uint64``.
+
+            :raises RuntimeError:
+              if ``xs`` does not have shape ``(N, 16)``, or if any of its
+              rows is not a valid element.
+          )pbdoc");
+
+      if (kind == kind16::transf) {
+        return;
+      }
+
+      x.def_static(
+          "inverses",
+          [kind](uint8_array const &xs, size_t number_of_threads) {
+            validate16(xs, kind, number_of_threads);
+            uint8_array    result({xs.shape(0), py::ssize_t(16)});
+            uint8_t const *xp  = xs.data();
+            uint8_t *      out = result.mutable_data();
+            py::gil_scoped_release release;
+            detail::parallel_for(xs.shape(0),
+                                 number_of_threads,
+                                 [xp, out](size_t first, size_t last) {
+                                   for (size_t k = first; k < last; ++k) {
+                                     inverse16(xp + 16 * k, out + 16 * k);
+                                   }
+                                 });
+            return result;
+          },
+          py::arg("xs"),
+          py::arg("number_of_threads") = 1,
+          R"pbdoc(
+            Returns the inverses of the elements in the array ``xs``, see
+            :py:meth:`products`.
+
+            :param xs: the elements.
+            :type xs: numpy.ndarray
+            :param number_of_threads: the number of threads (default: ``1``).
+            :type number_of_threads: int
+
+            :return:
+              A ``numpy.ndarray`` of shape ``(N, 16)`` and dtype ``uint8``.
+
+            :raises RuntimeError:
+              if ``xs`` does not have shape ``(N, 16)``, or if any of its
+              rows is not a valid element.
+          )pbdoc");
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // Construction from buffers
+    ////////////////////////////////////////////////////////////////////////
+
+    constexpr uint32_t undef32 = static_cast<uint32_t>(UNDEFINED);
+
+    // If <partial> is true, then negative values, and the maximum value of S,
+    // are UNDEFINED, as for partial perms; otherwise negative values are
+    // invalid, and the maximum value of S is an image like any other.
+    template <typename S>
+    void read_images(py::buffer_info const &info,
+                     std::vector<uint32_t> &images,
+                     bool                   partial) {
+      char const *ptr = static_cast<char const *>(info.ptr);
+      for (size_t i = 0; i < images.size(); ++i) {
+        S val;
+        std::memcpy(&val, ptr + i * info.strides[0], sizeof(S));
+        if (partial && (val < 0 || val == std::numeric_limits<S>::max())) {
+          images[i] = undef32;
+        } else if (val < 0) {
+          LIBSEMIGROUPS_EXCEPTION(
+              "image value out of bounds, expected value in [0, %llu), "
+              "found %lld in position %llu",
+              static_cast<uint64_t>(images.size()),
+              static_cast<int64_t>(val),
+              static_cast<uint64_t>(i));
+        } else if (static_cast<uint64_t>(val) >= images.size()) {
+          LIBSEMIGROUPS_EXCEPTION(
+              "image value out of bounds, expected value in [0, %llu), "
+              "found %llu in position %llu",
+              static_cast<uint64_t>(images.size()),
+              static_cast<uint64_t>(val),
+              static_cast<uint64_t>(i));
+        } else {
+          images[i] = static_cast<uint32_t>(val);
+        }
+      }
+    }
+
+    // Returns the images in the one-dimensional buffer <buf> of integers, see
+    // read_images for the meaning of <partial>.
+    std::vector<uint32_t> images_from_buffer(py::buffer const &buf,
+                                             bool               partial) {
+      py::buffer_info info = buf.request();
+      std::string     fmt  = info.format;
+      if (!fmt.empty() && (fmt[0] == '@' || fmt[0] == '=')) {
+        fmt = fmt.substr(1);
+      }
+      if (info.ndim != 1 || fmt.size() != 1
+          || std::string("bBhHiIlLqQ").find(fmt[0]) == std::string::npos) {
+        throw py::type_error("expected a one-dimensional buffer of integers "
+                             "in native byte order, found format \""
+                             + info.format + "\"");
+      }
+      if (static_cast<uint64_t>(info.shape[0]) > uint64_t(1) << 32) {
+        LIBSEMIGROUPS_EXCEPTION("expected at most %llu images, found %llu",
+                                uint64_t(1) << 32,
+                                static_cast<uint64_t>(info.shape[0]));
+      }
+      std::vector<uint32_t> images(info.shape[0]);
+      bool const            is_signed = std::islower(fmt[0]);
+      switch (info.itemsize) {
+        case 1:
+          is_signed ? read_images<int8_t>(info, images, partial)
+                    : read_images<uint8_t>(info, images, partial);
+          break;
+        case 2:
+          is_signed ? read_images<int16_t>(info, images, partial)
+                    : read_images<uint16_t>(info, images, partial);
+          break;
+        case 4:
+          is_signed ? read_images<int32_t>(info, images, partial)
+                    : read_images<uint32_t>(info, images, partial);
+          break;
+        default:
+          is_signed ? read_images<int64_t>(info, images, partial)
+                    : read_images<uint64_t>(info, images, partial);
+          break;
+      }
+      return images;
+    }
+
+    // Returns the T with images <images>, the remaining images of <cont> (if
+    // any) are left unchanged.
+    template <typename T>
+    T make_from_images(std::vector<uint32_t> const &images,
+                       typename T::container_type  cont) {
+      using value_type = typename T::value_type;
+      for (size_t i = 0; i < images.size(); ++i) {
+        cont[i] = (images[i] == undef32 ? static_cast<value_type>(UNDEFINED)
+                                        : static_cast<value_type>(images[i]));
+      }
+      return T::make(cont);
+    }
+
+    // Returns the element of the narrowest type in T16, T1, T2, T4 with the
+    // images in <buf>. Elements of degree less than 16 are padded with fixed
+    // points, as in the Python functions Transf, PPerm, and Perm. Partial is
+    // true if the elements are partial perms.
+    template <bool Partial,
+              typename T16,
+              typename T1,
+              typename T2,
+              typename T4>
+    py::object from_buffer(py::buffer const &buf) {
+      std::vector<uint32_t> images = images_from_buffer(buf, Partial);
+      size_t const          n      = images.size();
+      if (n <= 16) {
+        typename T16::container_type cont;
+        std::iota(cont.begin(), cont.end(), 0);
+        return py::cast(make_from_images<T16>(images, cont));
+      } else if (n <= (size_t(1) << 8)) {
+        return py::cast(make_from_images<T1>(
+            images, typename T1::container_type(n)));
+      } else if (n <= (size_t(1) << 16)) {
+        return py::cast(make_from_images<T2>(
+            images, typename T2::container_type(n)));
+      }
+      return py::cast(
+          make_from_images<T4>(images, typename T4::container_type(n)));
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // Parallel functions for Transf4, PPerm4, and Perm4
+    ////////////////////////////////////////////////////////////////////////
+
+    // Elements of degree less than this are not split between threads.
+    constexpr size_t min_degree_per_thread = size_t(1) << 16;
+
+    // The distance ahead of the current point at which the image of y is
+    // prefetched in products4.
+    constexpr size_t prefetch_distance = 16;
+
+    size_t number_of_threads4(size_t n, size_t number_of_threads) {
+      return std::min(number_of_threads, n / min_degree_per_thread + 1);
+    }
+
+    // Sets out[i] = y[x[i]] for every i in [first, last), where <n> is the
+    // degree. The composition is a gather from y, and so the cache lines of
+    // y are prefetched ahead of the point where they are read.
+    void products4(uint32_t const *x,
+                   uint32_t const *y,
+                   uint32_t *      out,
+                   size_t          first,
+                   size_t          last,
+                   size_t          n,
+                   bool            partial) {
+      for (size_t i = first; i < last; ++i) {
+#if defined(__GNUC__) || defined(__clang__)
+        if (i + prefetch_distance < n) {
+          uint32_t const j = x[i + prefetch_distance];
+          if (j != undef32) {
+            __builtin_prefetch(y + j);
+          }
+        }
+#else
+        (void) n;
+#endif
+        out[i] = (partial && x[i] == undef32) ? undef32 : y[x[i]];
+      }
+    }
+
+    size_t trailing_zeros(uint64_t w) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_ctzll(w);
+#else
+      size_t result = 0;
+      while ((w & 1) == 0) {
+        w >>= 1;
+        ++result;
+      }
+      return result;
+#endif
+    }
+
+    // Returns the images of <x> as bits in a vector of 64-bit blocks.
+    std::vector<std::atomic<uint64_t>> image_bits4(uint32_t const *x,
+                                                   size_t          n,
+                                                   size_t number_of_threads) {
+      std::vector<std::atomic<uint64_t>> bits((n + 63) / 64);
+      detail::parallel_for(
+          n, number_of_threads, [&x, &bits](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+              if (x[i] != undef32) {
+                bits[x[i] / 64].fetch_or(uint64_t(1) << (x[i] % 64),
+                                         std::memory_order_relaxed);
+              }
+            }
+          });
+      return bits;
+    }
+
+    // Installs the methods of Transf4, PPerm4, and Perm4 that split their
+    // work between several threads.
+    template <typename T, typename S>
+    void bind_parallel4(S &x, bool partial) {
+      x.def(
+           "product_inplace",
+           [partial](T &xy, T const &x, T const &y, size_t number_of_threads) {
+             if (x.degree() != y.degree() || xy.degree() != x.degree()) {
+               LIBSEMIGROUPS_EXCEPTION(
+                   "expected elements of equal degree, found %llu, %llu "
+                   "and %llu",
+                   static_cast<uint64_t>(xy.degree()),
+                   static_cast<uint64_t>(x.degree()),
+                   static_cast<uint64_t>(y.degree()));
+             } else if (&xy == &x || &xy == &y) {
+               LIBSEMIGROUPS_EXCEPTION(
+                   "cannot compute the product in place of one of its "
+                   "arguments");
+             }
+             size_t const n = x.degree();
+             if (n == 0) {
+               return;
+             }
+             uint32_t const *       xp  = &*x.cbegin();
+             uint32_t const *       yp  = &*y.cbegin();
+             uint32_t *             out = &xy[0];
+             py::gil_scoped_release release;
+             detail::parallel_for(
+                 n,
+                 number_of_threads4(n, number_of_threads),
+                 [&](size_t first, size_t last) {
+                   products4(xp, yp, out, first, last, n, partial);
+                 });
+           },
+           py::arg("x"),
+           py::arg("y"),
+           py::arg("number_of_threads"),
+           R"pbdoc(
+             Sets ``self`` to the product of ``x`` and ``y``, where the
+             images are computed by ``number_of_threads`` threads. Elements
+             of small degree are not split between threads.
+
+             :param x: the left-hand factor.
+             :type x: the type of ``self``
+             :param y: the right-hand factor.
+             :type y: the type of ``self``
+             :param number_of_threads: the number of threads.
+             :type number_of_threads: int
+
+             :return: (None)
+
+             :raises RuntimeError:
+               if ``x``, ``y`` and ``self`` do not have equal degrees, or
+               ``self`` is ``x`` or ``y``.
+           )pbdoc")
+          .def(
+              "rank",
+              [](T const &x, size_t number_of_threads) {
+                size_t const n = x.degree();
+                if (n == 0) {
+                  return size_t(0);
+                }
+                py::gil_scoped_release release;
+                number_of_threads = number_of_threads4(n, number_of_threads);
+                auto const bits
+                    = image_bits4(&*x.cbegin(), n, number_of_threads);
+                std::atomic<size_t> result(0);
+                detail::parallel_for(
+                    bits.size(),
+                    number_of_threads,
+                    [&bits, &result](size_t first, size_t last) {
+                      size_t count = 0;
+                      for (size_t i = first; i < last; ++i) {
+                        count += std::bitset<64>(bits[i].load()).count();
+                      }
+                      result += count;
+                    });
+                return result.load();
+              },
+              py::arg("number_of_threads"),
+              R"pbdoc(
+                Returns the number of distinct images of ``self``, where the
+                images are computed by ``number_of_threads`` threads.
+
+                :param number_of_threads: the number of threads.
+                :type number_of_threads: int
+
+                :return: An ``int``.
+              )pbdoc")
+          .def(
+              "image",
+              [](T const &x, size_t number_of_threads) {
+                size_t const n = x.degree();
+                if (n == 0) {
+                  return py::array_t<uint32_t>(0);
+                }
+                std::vector<std::atomic<uint64_t>> bits;
+                {
+                  py::gil_scoped_release release;
+                  bits = image_bits4(&*x.cbegin(),
+                                     n,
+                                     number_of_threads4(n, number_of_threads));
+                }
+                size_t count = 0;
+                for (auto const &b : bits) {
+                  count += std::bitset<64>(b.load()).count();
+                }
+                py::array_t<uint32_t> result(count);
+                uint32_t *            out = result.mutable_data();
+                py::gil_scoped_release release;
+                for (size_t i = 0; i < bits.size(); ++i) {
+                  uint64_t b = bits[i].load();
+                  while (b != 0) {
+                    *out++ = static_cast<uint32_t>(64 * i + trailing_zeros(b));
+                    b &= b - 1;
+                  }
+                }
+                return result;
+              },
+              py::arg("number_of_threads") = 1,
+              R"pbdoc(
+                Returns the sorted array of the distinct images of ``self``,
+                where the images are computed by ``number_of_threads``
+                threads.
+
+                :param number_of_threads:
+                  the number of threads (default: ``1``).
+                :type number_of_threads: int
+
+                :return: A ``numpy.ndarray`` of dtype ``uint32``.
+              )pbdoc");
     }
   }  // namespace
 
   void init_transf(py::module &m) {
     // Transformations
-    bind_transf<LeastTransf<16>>(m, "Transf16");
+    auto transf16 = bind_transf<LeastTransf<16>>(m, "Transf16");
+    bind_batch16(transf16, kind16::transf);
     bind_transf<Transf<0, uint8_t>>(m, "Transf1");
     bind_transf<Transf<0, uint16_t>>(m, "Transf2");
-    bind_transf<Transf<0, uint32_t>>(m, "Transf4");
+    auto transf4 = bind_transf<Transf<0, uint32_t>>(m, "Transf4");
+    bind_parallel4<Transf<0, uint32_t>>(transf4, false);
 
     // Partial perms
-    bind_pperm<LeastPPerm<16>>(m, "PPerm16");
+    auto pperm16 = bind_pperm<LeastPPerm<16>>(m, "PPerm16");
+    bind_batch16(pperm16, kind16::pperm);
     bind_pperm<PPerm<0, uint8_t>>(m, "PPerm1");
     bind_pperm<PPerm<0, uint16_t>>(m, "PPerm2");
-    bind_pperm<PPerm<0, uint32_t>>(m, "PPerm4");
+    auto pperm4 = bind_pperm<PPerm<0, uint32_t>>(m, "PPerm4");
+    bind_parallel4<PPerm<0, uint32_t>>(pperm4, true);
 
     // Perms
-    bind_perm<LeastPerm<16>, LeastTransf<16>>(m, "Perm16");
+    auto perm16 = bind_perm<LeastPerm<16>, LeastTransf<16>>(m, "Perm16");
+    bind_batch16(perm16, kind16::perm);
     bind_perm<Perm<0, uint8_t>, Transf<0, uint8_t>>(m, "Perm1");
     bind_perm<Perm<0, uint16_t>, Transf<0, uint16_t>>(m, "Perm2");
-    bind_perm<Perm<0, uint32_t>, Transf<0, uint32_t>>(m, "Perm4");
+    auto perm4 = bind_perm<Perm<0, uint32_t>, Transf<0, uint32_t>>(m, "Perm4");
+    bind_parallel4<Perm<0, uint32_t>>(perm4, false);
+
+    // Construction from buffers
+    m.def("transf_from_buffer",
+          &from_buffer<false,
+                       LeastTransf<16>,
+                       Transf<0, uint8_t>,
+                       Transf<0, uint16_t>,
+                       Transf<0, uint32_t>>,
+          py::arg("images"),
+          R"pbdoc(
+            Returns the transformation with the images in the
+            one-dimensional buffer ``images``, such as a ``bytes`` object, a
+            ``numpy.ndarray`` or an ``array.array`` of integers. The returned
+            transformation is a ``Transf16``, ``Transf1``, ``Transf2``, or
+            ``Transf4``, whichever is the narrowest that can hold it, as in
+            :py:func:`Transf`. The images are read directly from the buffer.
+
+            :param images: the images.
+            :type images: buffer
+
+            :return: A transformation.
+
+            :raises TypeError:
+              if ``images`` is not a one-dimensional buffer of integers.
+            :raises RuntimeError:
+              if ``images`` contains a negative value, or is not a
+              transformation.
+          )pbdoc");
+    m.def("pperm_from_buffer",
+          &from_buffer<true,
+                       LeastPPerm<16>,
+                       PPerm<0, uint8_t>,
+                       PPerm<0, uint16_t>,
+                       PPerm<0, uint32_t>>,
+          py::arg("images"),
+          R"pbdoc(
+            Returns the partial perm with the images in the one-dimensional
+            buffer ``images``, see :py:func:`transf_from_buffer`. Negative
+            values and the maximum value of the type of the entries of
+            ``images``, such as ``255`` in a ``bytes`` object, are undefined
+            images.
+
+            :param images: the images.
+            :type images: buffer
+
+            :return: A partial perm.
+
+            :raises TypeError:
+              if ``images`` is not a one-dimensional buffer of integers.
+            :raises RuntimeError: if ``images`` is not a partial perm.
+          )pbdoc");
+    m.def("perm_from_buffer",
+          &from_buffer<false,
+                       LeastPerm<16>,
+                       Perm<0, uint8_t>,
+                       Perm<0, uint16_t>,
+                       Perm<0, uint32_t>>,
+          py::arg("images"),
+          R"pbdoc(
+            Returns the permutation with the images in the one-dimensional
+            buffer ``images``, see :py:func:`transf_from_buffer`.
+
+            :param images: the images.
+            :type images: buffer
+
+            :return: A permutation.
+
+            :raises TypeError:
+              if ``images`` is not a one-dimensional buffer of integers.
+            :raises RuntimeError:
+              if ``images`` contains a negative value, or is not a
+              permutation.
+          )pbdoc");
   }
 }  // namespace libsemigroups
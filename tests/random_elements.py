@@ -0,0 +1,50 @@
+# -*- coding: utf-8 -*-
+# pylint: disable=no-name-in-module, missing-function-docstring
+# pylint: disable=missing-class-docstring, invalid-name
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+"""
+This module contains some functions returning random elements of degree n of
+the type T, using the random number generator rng, used in tests for arrays,
+sets and dictionaries of elements.
+"""
+
+from _libsemigroups_pybind11 import Bipartition, PBR
+
+
+def random_transf(T, n, rng):
+    return T.make([rng.randrange(n) for _ in range(n)])
+
+
+def random_pperm(T, n, rng):
+    dom = [i for i in range(n) if rng.random() < 0.7]
+    ran = rng.sample(range(n), len(dom))
+    return T.make(dom, ran, n)
+
+
+def random_perm(T, n, rng):
+    images = list(range(n))
+    rng.shuffle(images)
+    return T.make(images)
+
+
+def random_bipartition(_, n, rng):
+    blocks, lookup = {}, []
+    for _ in range(2 * n):
+        b = rng.randrange(n)
+        lookup.append(blocks.setdefault(b, len(blocks)))
+    return Bipartition.make(lookup)
+
+
+def random_pbr(_, n, rng):
+    return PBR.make(
+        [
+            [j for j in range(2 * n) if rng.random() < 0.2]
+            for _ in range(2 * n)
+        ]
+    )
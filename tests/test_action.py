@@ -0,0 +1,125 @@
+# -*- coding: utf-8 -*-
+# pylint: disable=no-name-in-module, missing-function-docstring
+# pylint: disable=missing-class-docstring, invalid-name
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+"""
+This module contains some tests for actions.
+"""
+
+from itertools import product
+
+import pytest
+
+from _libsemigroups_pybind11 import (
+    BMat8,
+    PPerm1,
+    PPerm16,
+    Perm16,
+    Transf1,
+    Transf16,
+    RightActionTransf16UInt8,
+    RightActionTransf1UInt8,
+)
+
+from libsemigroups_pybind11 import (
+    LeftAction,
+    ReportGuard,
+    RightAction,
+    UNDEFINED,
+)
+
+
+def test_action_points():
+    ReportGuard(False)
+    o = RightAction([Perm16.make(list(range(1, 16)) + [0])], [0])
+    assert o.size() == 16
+    assert sorted(o) == list(range(16))
+    assert o.position(5) != UNDEFINED
+    assert o[o.position(5)] == 5
+
+
+def test_action_points_scc():
+    ReportGuard(False)
+    o = RightActionTransf16UInt8()
+    o.add_seed(0)
+    o.add_generator(Transf16.make([1, 0, 2] + list(range(3, 16))))
+    o.add_generator(Transf16.make([2, 2, 2] + list(range(3, 16))))
+    assert o.number_of_generators() == 2
+    assert o.size() == 3
+    assert o.digraph().number_of_nodes() == 3
+    assert o.digraph().number_of_scc() == 2
+
+    for i in range(o.size()):
+        root = o.root_of_scc(o[i])
+        assert o.multiplier_to_scc_root(i)[o[i]] == root
+        assert o.multiplier_from_scc_root(i)[root] == o[i]
+
+
+def test_action_pperm():
+    ReportGuard(False)
+    gens = [
+        PPerm16.make([0, 1, 2, 3], [1, 0, 2, 3], 16),
+        PPerm16.make([0, 1, 2, 3], [1, 2, 3, 0], 16),
+        PPerm16.make([1, 2, 3], [1, 2, 3], 16),
+    ]
+    seed = PPerm16.make([0, 1, 2, 3], [0, 1, 2, 3], 16)
+    assert RightAction(gens, [seed]).size() == 16
+    assert LeftAction(gens, [seed]).size() == 16
+
+
+def test_action_bmat8():
+    ReportGuard(False)
+    gens = [
+        BMat8([[a, b], [c, d]]) for a, b, c, d in product([0, 1], repeat=4)
+    ]
+    seed = BMat8([[1, 0], [0, 1]])
+    row_orb = RightAction(gens, [seed.row_space_basis()])
+    assert row_orb.size() == 7
+    col_orb = LeftAction(gens, [seed.col_space_basis()])
+    assert col_orb.size() == 7
+
+
+def test_action_runner():
+    ReportGuard(False)
+    o = RightAction([Perm16.make(list(range(1, 16)) + [0])], [0])
+    assert not o.started()
+    o.run()
+    assert o.finished()
+    assert o.current_size() == 16
+
+
+def test_action_exceptions():
+    with pytest.raises(ValueError):
+        RightAction([], [0])
+    with pytest.raises(TypeError):
+        LeftAction([Perm16.make(list(range(16)))], [0])
+    o = RightAction([Perm16.make(list(range(16)))], [0])
+    with pytest.raises(RuntimeError):
+        o[1]  # pylint: disable=pointless-statement
+
+
+def test_action_out_of_range():
+    with pytest.raises(RuntimeError):
+        RightAction([Transf1.make([1, 0, 2])], [7])
+    with pytest.raises(RuntimeError):
+        RightAction([Transf1.make([1, 0, 2])], [0, 3])
+    with pytest.raises(RuntimeError):
+        RightAction([Transf1.make([1, 0, 2]), Transf1.make([0, 0])], [0])
+    with pytest.raises(RuntimeError):
+        RightAction([PPerm1.make([0], [1], 3)], [PPerm1.make([0], [0], 4)])
+
+    # Seeds added before any generators are checked too
+    o = RightActionTransf1UInt8()
+    o.add_seed(7)
+    with pytest.raises(RuntimeError):
+        o.add_generator(Transf1.make([1, 0, 2]))
+    assert o.number_of_generators() == 0
+
+    o = RightAction([Transf1.make([1, 0, 2])], [0])
+    assert o.size() == 2
@@ -0,0 +1,127 @@
+# -*- coding: utf-8 -*-
+# pylint: disable=no-name-in-module, missing-function-docstring
+# pylint: disable=missing-class-docstring, invalid-name
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+"""
+This module contains some tests for BMat8.
+"""
+
+from random import Random
+
+import numpy
+
+from libsemigroups_pybind11 import BMat8
+
+
+def random_array(n, rng):
+    return numpy.array(
+        [rng.getrandbits(64) for _ in range(n)], dtype=numpy.uint64
+    )
+
+
+def test_batch_functions():
+    rng = Random(1234)
+    a = random_array(200, rng)
+    xs = [BMat8(int(y)) for y in a]
+    for threads in (1, 4):
+        assert list(BMat8.row_space_sizes(a, threads)) == [
+            x.row_space_size() for x in xs
+        ]
+        assert list(BMat8.row_space_bases(a, threads)) == [
+            x.row_space_basis().to_int() for x in xs
+        ]
+        assert list(BMat8.col_space_bases(a, threads)) == [
+            x.col_space_basis().to_int() for x in xs
+        ]
+        assert list(BMat8.minimum_dims(a, threads)) == [
+            x.minimum_dim() for x in xs
+        ]
+        assert list(BMat8.are_regular_elements(a, threads)) == [
+            x.is_regular_element() for x in xs
+        ]
+
+
+def test_batch_functions_shape():
+    rng = Random(4321)
+    a = random_array(12, rng).reshape((3, 4))
+    result = BMat8.row_space_sizes(a, number_of_threads=2)
+    assert result.shape == (3, 4)
+    assert result.dtype == numpy.uint64
+    assert BMat8.are_regular_elements(a).dtype == bool
+    for i in range(3):
+        for j in range(4):
+            assert result[i, j] == BMat8(int(a[i, j])).row_space_size()
+
+    assert BMat8.row_space_sizes(numpy.array([], dtype=numpy.uint64)).size == 0
+    x = BMat8([[0, 1], [1, 0]])
+    assert list(BMat8.row_space_sizes([x.to_int()])) == [4]
+    assert list(BMat8.minimum_dims([x.to_int(), 0])) == [2, 0]
+
+
+def random_permutation(x, rng):
+    rows, cols = list(range(8)), list(range(8))
+    rng.shuffle(rows)
+    rng.shuffle(cols)
+    return BMat8(
+        [[x.get(rows[i], cols[j]) for j in range(8)] for i in range(8)]
+    )
+
+
+def test_canonical_form():
+    rng = Random(5678)
+    for _ in range(200):
+        x = BMat8(rng.getrandbits(64) & rng.getrandbits(64))
+        y = random_permutation(x, rng)
+        assert x.canonical_form() == y.canonical_form()
+        assert x.canonical_form() == x.canonical_form().canonical_form()
+        assert not x < x.canonical_form()
+        assert x.canonical_form(True) == y.transpose().canonical_form(True)
+
+    x = BMat8([[1, 0], [1, 1]])
+    assert x.canonical_form() == BMat8([[1, 1], [0, 1]]).canonical_form()
+    assert x.canonical_form() != x.transpose().canonical_form()
+    assert x.canonical_form(True) == x.transpose().canonical_form(True)
+    assert BMat8(0).canonical_form() == BMat8(0)
+    identity = BMat8([[int(i == j) for j in range(8)] for i in range(8)])
+    assert identity.canonical_form() == BMat8(
+        [[int(i + j == 7) for j in range(8)] for i in range(8)]
+    )
+
+
+def test_canonical_forms():
+    # The numbers of n x n Boolean matrices up to permuting rows and columns
+    # (OEIS A002724), and also transposing (OEIS A002725).
+    for n, expected, expected_transpose in ((2, 7, 6), (3, 36, 26)):
+        a = numpy.array(
+            [
+                BMat8(
+                    [
+                        [(k >> (n * i + j)) & 1 for j in range(n)]
+                        for i in range(n)
+                    ]
+                ).to_int()
+                for k in range(2 ** (n * n))
+            ],
+            dtype=numpy.uint64,
+        )
+        assert len(numpy.unique(BMat8.canonical_forms(a))) == expected
+        assert (
+            len(numpy.unique(BMat8.canonical_forms(a, transpose=True)))
+            == expected_transpose
+        )
+
+    rng = Random(8765)
+    a = random_array(100, rng)
+    for threads in (1, 3):
+        assert list(BMat8.canonical_forms(a, number_of_threads=threads)) == [
+            BMat8(int(y)).canonical_form().to_int() for y in a
+        ]
+        assert list(BMat8.canonical_forms(a, True, threads)) == [
+            BMat8(int(y)).canonical_form(True).to_int() for y in a
+        ]
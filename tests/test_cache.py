@@ -0,0 +1,134 @@
+# -*- coding: utf-8 -*-
+# pylint: disable=no-name-in-module, missing-function-docstring
+# pylint: disable=missing-class-docstring, invalid-name
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+"""
+This module contains some tests for the on-disk cache of presentations.
+"""
+
+import pytest
+
+from libsemigroups_pybind11 import (
+    POSITIVE_INFINITY,
+    Presentation,
+    PresentationCache,
+    ReportGuard,
+    canonical_form,
+    congruence_kind,
+    presentation_hash,
+)
+
+
+def make_presentation(alphabet, rules, contains_empty_word=False):
+    p = Presentation()
+    p.alphabet(alphabet)
+    p.contains_empty_word(contains_empty_word)
+    for u, v in rules:
+        p.add_rule_and_check(u, v)
+    return p
+
+
+def commutative():
+    return make_presentation(
+        2, [([0, 0, 0], [0]), ([1, 1], [1]), ([0, 1], [1, 0])]
+    )
+
+
+def commutative_relabelled():
+    return make_presentation(
+        [3, 5], [([3, 5], [5, 3]), ([3], [3, 3]), ([5], [5, 5, 5])]
+    )
+
+
+def test_canonical_form():
+    p, q = commutative(), commutative_relabelled()
+    assert canonical_form(p) == canonical_form(q)
+    assert canonical_form(p) == {
+        "kind": "twosided",
+        "number_of_letters": 2,
+        "contains_empty_word": False,
+        "rules": [[[0, 0], [0]], [[1, 0], [0, 1]], [[1, 1, 1], [1]]],
+    }
+    assert presentation_hash(p) == presentation_hash(q)
+    assert len(presentation_hash(p)) == 64
+    assert presentation_hash(p) != presentation_hash(p, congruence_kind.left)
+    p.contains_empty_word(True)
+    assert presentation_hash(p) != presentation_hash(q)
+
+
+def test_canonical_form_duplicate_rules():
+    rules = [([0, 0, 0], [0]), ([1, 1, 1], [1, 1])]
+    p = make_presentation(2, rules)
+    q = make_presentation(2, rules + [([0, 0, 0], [0])])
+    assert canonical_form(p) == canonical_form(q)
+    assert presentation_hash(p) == presentation_hash(q)
+
+
+def test_size_and_coset_table(tmp_path):
+    ReportGuard(False)
+    cache = PresentationCache(str(tmp_path))
+    assert cache.directory == str(tmp_path)
+    assert len(cache) == 0
+    p, q = commutative(), commutative_relabelled()
+    assert p not in cache
+    assert cache.size(p) == 5
+    assert p in cache and q in cache
+    assert len(cache) == 1
+    assert cache.size(q) == 5
+    assert len(cache) == 1
+
+    t = cache.coset_table(p)
+    assert len(t) == 5 and all(len(row) == 2 for row in t)
+    # The letters 3 and 5 of q correspond to 1 and 0 of p, respectively
+    assert cache.coset_table(q) == [[row[1], row[0]] for row in t]
+
+    # A new instance sees the results stored by the previous one
+    assert PresentationCache(str(tmp_path)).size(q) == 5
+    cache.clear()
+    assert len(cache) == 0
+
+
+def test_knuth_bendix_and_fpsemigroup(tmp_path):
+    ReportGuard(False)
+    cache = PresentationCache(str(tmp_path))
+    p = commutative()
+    kb = cache.knuth_bendix(p)
+    assert kb.confluent()
+    assert kb.size() == 5
+
+    # The cached rules are confluent for the order of the letters in the
+    # canonical form, which is not the order of the letters of q.
+    kb = cache.knuth_bendix(commutative_relabelled())
+    kb.run()
+    assert kb.confluent()
+    assert kb.size() == 5
+    assert kb.equal_to([0, 1], [1, 0])
+
+    S = cache.fpsemigroup(p)
+    assert S.size() == 5
+
+
+def test_monoid(tmp_path):
+    ReportGuard(False)
+    cache = PresentationCache(str(tmp_path))
+    p = make_presentation(1, [([0, 0], [])], True)
+    assert cache.size(p) == 2
+    assert len(cache.coset_table(p)[0]) == 2
+
+
+def test_infinite(tmp_path):
+    ReportGuard(False)
+    cache = PresentationCache(str(tmp_path))
+    for kind in (congruence_kind.twosided, congruence_kind.right):
+        p = make_presentation(2, [([0, 0], [0])])
+        assert cache.size(p, kind) == POSITIVE_INFINITY
+        with pytest.raises(ValueError):
+            cache.coset_table(p, kind)
+    assert len(cache) == 2
+    assert PresentationCache(str(tmp_path)).size(p) == POSITIVE_INFINITY
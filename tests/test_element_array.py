@@ -0,0 +1,165 @@
+# -*- coding: utf-8 -*-
+# pylint: disable=no-name-in-module, missing-function-docstring
+# pylint: disable=missing-class-docstring, invalid-name
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+"""
+This module contains some tests for arrays of elements.
+"""
+
+from random import Random
+
+import numpy
+import pytest
+
+from _libsemigroups_pybind11 import (
+    Transf1,
+    Transf2,
+    PPerm1,
+    PPerm4,
+    Perm1,
+    Perm2,
+    Bipartition,
+    PBR,
+    Transf1Array,
+    BipartitionArray,
+)
+
+from libsemigroups_pybind11 import ElementArray, FroidurePin, ReportGuard
+
+from random_elements import (
+    random_bipartition,
+    random_pbr,
+    random_perm,
+    random_pperm,
+    random_transf,
+)
+
+
+ELEMENTS = [
+    (Transf1, random_transf, True),
+    (Transf2, random_transf, True),
+    (PPerm1, random_pperm, True),
+    (PPerm4, random_pperm, True),
+    (Perm1, random_perm, True),
+    (Perm2, random_perm, True),
+    (Bipartition, random_bipartition, True),
+    (PBR, random_pbr, False),
+]
+
+
+@pytest.mark.parametrize("T, random_element, sorted_by_lt", ELEMENTS)
+def test_element_array(T, random_element, sorted_by_lt):
+    rng = Random(41)
+    n = 6
+    xs = [random_element(T, n, rng) for _ in range(50)]
+    ys = [random_element(T, n, rng) for _ in range(50)]
+    a, b = ElementArray(xs), ElementArray(ys)
+
+    assert type(a).element_type is T
+    assert len(a) == 50
+    assert a.degree() == n
+    assert list(a) == xs
+    assert a.to_list() == xs
+    assert a == ElementArray(a)
+    assert a != b
+
+    for threads in (1, 4):
+        assert type(a).products(a, b, threads).to_list() == [
+            x * y for x, y in zip(xs, ys)
+        ]
+    assert (a * b).to_list() == [x * y for x, y in zip(xs, ys)]
+
+    c = ElementArray(xs)
+    c[3] = ys[3]
+    assert c[3] == ys[3]
+    assert list(a.equal(c)) == [i != 3 or xs[3] == ys[3] for i in range(50)]
+    c.append(xs[0])
+    assert len(c) == 51
+
+    hashes = ElementArray(xs + xs).hashes()
+    assert list(hashes[:50]) == list(hashes[50:])
+
+    distinct = []
+    for x in xs + ys:
+        if all(x != y for y in distinct):
+            distinct.append(x)
+    c = ElementArray(xs + ys + xs)
+    u = c.unique()
+    assert len(u) == len(distinct)
+    assert all(any(x == y for y in distinct) for x in u)
+    c.sort()
+    if sorted_by_lt:
+        assert c.to_list() == sorted(xs + ys + xs)
+        assert u.to_list() == sorted(distinct)
+
+    with pytest.raises(IndexError):
+        a[50]  # pylint: disable=pointless-statement
+    with pytest.raises(RuntimeError):
+        a.append(random_element(T, n + 1, rng))
+    with pytest.raises(RuntimeError):
+        type(a).products(a, ElementArray(ys[:49]))
+
+
+def test_element_array_froidure_pin():
+    ReportGuard(False)
+    gens = [Transf1.make([1, 2, 3, 0]), Transf1.make([1, 0, 2, 3])]
+    gens.append(Transf1.make([0, 0, 2, 3]))
+    S = FroidurePin(gens)
+    a = ElementArray(S)
+    assert isinstance(a, Transf1Array)
+    assert a.to_list() == gens
+    assert FroidurePin(a).size() == S.size() == 256
+    assert a.froidure_pin().size() == 256
+
+    assert len(Transf1Array(4)) == 0
+    assert BipartitionArray(3).degree() == 3
+    with pytest.raises(RuntimeError):
+        Transf1Array(4).froidure_pin()
+    with pytest.raises(ValueError):
+        ElementArray([])
+    with pytest.raises(TypeError):
+        ElementArray([1, 2, 3])
+
+
+def test_bipartition_array_numpy():
+    rng = Random(7)
+    n = 5
+    xs = [random_bipartition(Bipartition, n, rng) for _ in range(100)]
+    lookups = numpy.array(
+        [[x[i] for i in range(2 * n)] for x in xs], dtype="uint32"
+    )
+
+    a = BipartitionArray.from_numpy(lookups)
+    assert a.degree() == n
+    assert a.to_list() == xs
+    assert a == ElementArray(xs)
+    assert (a.to_numpy() == lookups).all()
+    assert BipartitionArray.from_numpy(lookups.astype("int64")) == a
+    assert list(a.ranks()) == [x.rank() for x in xs]
+
+    transverse = a.transverse_blocks()
+    assert transverse.shape == (100, 2 * n)
+    for x, row in zip(xs, transverse):
+        k = x.number_of_blocks()
+        assert list(row[:k]) == [x.is_transverse_block(i) for i in range(k)]
+        assert not row[k:].any()
+
+    empty = BipartitionArray.from_numpy(numpy.zeros((0, 6), dtype="uint32"))
+    assert len(empty) == 0 and empty.degree() == 3
+    assert empty.to_numpy().shape == (0, 6)
+    assert empty.ranks().shape == (0,)
+
+    with pytest.raises(RuntimeError):
+        BipartitionArray.from_numpy(numpy.zeros(6, dtype="uint32"))
+    with pytest.raises(RuntimeError):
+        BipartitionArray.from_numpy(numpy.zeros((2, 5), dtype="uint32"))
+    with pytest.raises(RuntimeError):
+        BipartitionArray.from_numpy(numpy.array([[0, 2, 1, 1]]))
+    with pytest.raises(RuntimeError):
+        BipartitionArray.from_numpy(numpy.array([[1, 0, 0, 1]]))
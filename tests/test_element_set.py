@@ -0,0 +1,212 @@
+# -*- coding: utf-8 -*-
+# pylint: disable=no-name-in-module, missing-function-docstring
+# pylint: disable=missing-class-docstring, invalid-name
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+"""
+This module contains some tests for hashing, and for sets and dictionaries of
+elements.
+"""
+
+from concurrent.futures import ThreadPoolExecutor
+from random import Random
+
+import pytest
+
+from _libsemigroups_pybind11 import (
+    Transf16,
+    Transf1,
+    PPerm2,
+    Perm4,
+    Bipartition,
+    PBR,
+    BMat8,
+    BMat,
+    IntMat3,
+    BMat5,
+    MaxPlusMat2,
+    PackedBMat,
+    Transf1Set,
+    Transf1Dict,
+)
+
+from libsemigroups_pybind11 import (
+    ElementArray,
+    ElementDict,
+    ElementSet,
+    FroidurePin,
+    ReportGuard,
+)
+
+from random_elements import (
+    random_bipartition,
+    random_pbr,
+    random_perm,
+    random_pperm,
+    random_transf,
+)
+
+
+def random_bmat8(_, n, rng):
+    return BMat8([[rng.randrange(2) for _ in range(n)] for _ in range(n)])
+
+
+def random_matrix(T, n, rng):
+    return T([[rng.randrange(2) for _ in range(n)] for _ in range(n)])
+
+
+def random_packed_bmat(_, n, rng):
+    return PackedBMat(
+        [[rng.randrange(2) for _ in range(n)] for _ in range(n)]
+    )
+
+
+ELEMENTS = [
+    (Transf16, random_transf, 16, False),
+    (Transf1, random_transf, 5, True),
+    (PPerm2, random_pperm, 5, True),
+    (Perm4, random_perm, 5, True),
+    (Bipartition, random_bipartition, 3, True),
+    (PBR, random_pbr, 2, True),
+    (BMat8, random_bmat8, 3, False),
+    (BMat, random_matrix, 3, False),
+    (IntMat3, random_matrix, 3, False),
+    (BMat5, random_matrix, 5, False),
+    (MaxPlusMat2, random_matrix, 2, False),
+    (PackedBMat, random_packed_bmat, 3, False),
+]
+
+
+def random_elements(T, random_element, n, k):
+    rng = Random(k)
+    return [random_element(T, n, rng) for _ in range(k)]
+
+
+@pytest.mark.parametrize("T, random_element, n, has_array", ELEMENTS)
+def test_hash(T, random_element, n, has_array):
+    # pylint: disable=unused-argument
+    xs = random_elements(T, random_element, n, 100)
+    ys = random_elements(T, random_element, n, 100)
+    for x, y in zip(xs, ys):
+        assert hash(x) == hash(y) or x != y
+    d = {x: i for i, x in enumerate(xs)}
+    assert all(xs[d[x]] == x for x in xs)
+    assert len(set(xs)) == len(
+        [x for i, x in enumerate(xs) if all(x != y for y in xs[:i])]
+    )
+
+
+@pytest.mark.parametrize("T, random_element, n, has_array", ELEMENTS)
+def test_element_set(T, random_element, n, has_array):
+    xs = random_elements(T, random_element, n, 50)
+    ys = random_elements(T, random_element, n, 51)
+    distinct = [x for i, x in enumerate(xs) if all(x != y for y in xs[:i])]
+
+    s = ElementSet(T)
+    assert type(s).element_type is T
+    assert len(s) == 0
+    for x in xs:
+        s.add(x)
+    assert len(s) == len(distinct)
+    assert all(x in s for x in xs)
+    assert s == ElementSet(xs)
+    assert s != ElementSet(T)
+    assert sorted(s.to_list()) == sorted(distinct)
+    assert len(list(s)) == len(s)
+    assert list(s.contains(ys)) == [any(y == x for x in xs) for y in ys]
+    assert 1 not in s
+
+    t = ElementSet(T)
+    t.update(xs)
+    assert s == t
+    t.remove(xs[0])
+    assert xs[0] not in t
+    with pytest.raises(KeyError):
+        t.remove(xs[0])
+    t.discard(xs[0])
+    t.clear()
+    assert len(t) == 0
+
+    if has_array:
+        a = ElementArray(xs)
+        assert ElementSet(a) == s
+        t.update(a)
+        assert t == s
+        assert list(s.contains(ElementArray(ys))) == list(s.contains(ys))
+
+
+@pytest.mark.parametrize("T, random_element, n, has_array", ELEMENTS)
+def test_element_dict(T, random_element, n, has_array):
+    xs = random_elements(T, random_element, n, 50)
+    ys = random_elements(T, random_element, n, 51)
+
+    d = ElementDict(T)
+    assert type(d).element_type is T
+    for i, x in enumerate(xs):
+        d[x] = i
+    assert all(xs[d[x]] == x for x in xs)
+    assert len(d) == len(d.keys()) == len(d.values()) == len(list(d))
+    assert all(d[k] == v for k, v in d.items())
+    assert list(d.contains(ys)) == [any(y == x for x in xs) for y in ys]
+    assert d.get(xs[0]) == d[xs[0]]
+    del d[xs[0]]
+    assert xs[0] not in d
+    assert d.get(xs[0]) is None
+    assert d.get(xs[0], -1) == -1
+    with pytest.raises(KeyError):
+        d[xs[0]]  # pylint: disable=pointless-statement
+    with pytest.raises(KeyError):
+        del d[xs[0]]
+
+    e = ElementDict({x: i for i, x in enumerate(xs)})
+    assert isinstance(e, type(d))
+    assert all(xs[e[x]] == x for x in xs)
+
+    if has_array:
+        assert list(d.contains(ElementArray(ys))) == list(d.contains(ys))
+
+
+def test_threads():
+    xs = random_elements(Transf1, random_transf, 6, 2000)
+    s = ElementSet(Transf1)
+
+    def update_or_contains(i):
+        ys = xs[100 * i : 100 * (i + 1)]
+        if i % 2 == 0:
+            s.update(ys)
+            return None
+        return s.contains(ys)
+
+    with ThreadPoolExecutor(max_workers=4) as pool:
+        list(pool.map(update_or_contains, range(20)))
+    added = [x for i, x in enumerate(xs) if (i // 100) % 2 == 0]
+    assert s == ElementSet(added)
+
+
+def test_froidure_pin():
+    ReportGuard(False)
+    S = FroidurePin(Transf1.make([1, 0, 2]), Transf1.make([0, 0, 2]))
+    n = S.size()
+    s = ElementSet(list(S))
+    assert len(s) == n
+    assert all(s.contains(list(S)))
+
+
+def test_exceptions():
+    with pytest.raises(ValueError):
+        ElementSet([])
+    with pytest.raises(ValueError):
+        ElementDict({})
+    with pytest.raises(TypeError):
+        ElementSet([1, 2])
+    with pytest.raises(TypeError):
+        ElementSet(int)
+    with pytest.raises(TypeError):
+        ElementDict([Transf1.make([0, 1])])
+    assert isinstance(ElementSet(Transf1), Transf1Set)
+    assert isinstance(ElementDict(Transf1), Transf1Dict)
@@ -165,3 +165,24 @@ class TestFpSemigroup(unittest.TestCase):
         self.assertEqual(S.size(), 240)
         self.assertFalse(S.has_froidure_pin())
         S.froidure_pin()
+
+    def test_kambites(self):
+        ReportGuard(False)
+        S = FpSemigroup()
+        S.set_alphabet("abcdefg")
+        S.add_rule("abcd", "efg")
+        self.assertTrue(S.has_kambites())
+        self.assertGreaterEqual(S.kambites().small_overlap_class(), 4)
+        self.assertIs(S.kambites(), S.kambites())
+        self.assertEqual(S.size(), POSITIVE_INFINITY)
+        self.assertTrue(S.equal_to("aabcdd", "aefgd"))
+        self.assertFalse(S.equal_to("abcd", "abc"))
+        self.assertEqual(
+            S.kambites().normal_form("efg" * 1000), "abcd" * 1000
+        )
+
+        # Adding a rule which breaks C(4) falls back on the other algorithms
+        S.add_rule("a", "b")
+        self.assertFalse(S.has_kambites())
+        self.assertEqual(S.kambites().number_of_rules(), 2)
+        self.assertTrue(S.equal_to("a", "b"))
@@ -13,6 +13,7 @@ This module contains some tests for FroidurePin
 """
 
 from datetime import timedelta
+from itertools import permutations
 import pytest
 from runner import check_runner
 
@@ -36,6 +37,7 @@ from _libsemigroups_pybind11 import (
 )
 
 from libsemigroups_pybind11 import (
+    ElementArray,
     FroidurePin,
     ReportGuard,
     ToddCoxeter,
@@ -45,6 +47,7 @@ from libsemigroups_pybind11 import (
     congruence_kind,
     Matrix,
     MatrixKind,
+    UNDEFINED,
 )
 
 
@@ -139,6 +142,46 @@ def check_mem_compare(S):
         assert S.equal_to(w + w, w)
 
 
+def check_freeze(S):
+    ReportGuard(False)
+    F = S.freeze()
+    assert S.finished()
+    assert type(F).element_type is type(S).element_type
+    assert len(F) == F.size() == S.size()
+    assert list(F) == list(S)
+    assert [F.position(x) for x in S] == list(range(S.size()))
+    assert all(F.contains(x) and x in F for x in S)
+    for i in range(S.size()):
+        assert F.at(i) == F[i] == S.at(i)
+
+    with pytest.raises(RuntimeError):
+        F.at(S.size())
+    with pytest.raises(IndexError):
+        F[S.size()]  # pylint: disable=pointless-statement
+
+
+def check_batched_lookups(S):
+    ReportGuard(False)
+    gens = [S.generator(i) for i in range(S.number_of_generators())]
+    assert list(S.current_positions(gens)) == [
+        S.current_position(x) for x in gens
+    ]
+    S.run()
+    xs = list(S)[::-1]
+    for threads in (1, 3):
+        pos = [S.position(x) for x in xs]
+        assert list(S.positions(xs, threads)) == pos
+        assert list(S.current_positions(xs, threads)) == pos
+        assert list(S.sorted_positions(xs, threads)) == [
+            S.sorted_position(x) for x in xs
+        ]
+        assert S.contains(xs, threads).all()
+        F = S.freeze()
+        assert list(F.positions(xs, threads)) == pos
+        assert F.contains(xs, threads).all()
+    assert len(S.positions([])) == 0
+
+
 def check_accessors(S):
     ReportGuard(False)
     # current_size
@@ -309,6 +352,8 @@ def checks_for_froidure_pin():
     return (
         check_settings,
         check_mem_compare,
+        check_freeze,
+        check_batched_lookups,
         check_accessors,
         check_attributes,
         check_idempotents,
@@ -586,3 +631,63 @@ def test_froidure_pin_ntp(checks_for_froidure_pin, checks_for_generators):
 
     for check in checks_for_froidure_pin:
         check(FroidurePin(gens))
+
+
+def test_froidure_pin_freeze():
+    ReportGuard(False)
+    S = FroidurePin([Transf1.make([1, 0, 2]), Transf1.make([1, 2, 0])])
+    F = S.freeze()
+    assert F.size() == 6
+    assert F.position(Transf1.make([0, 0, 1])) == UNDEFINED
+    assert not F.contains(Transf1.make([0, 0, 1]))
+    assert Transf1.make([0, 0, 1]) not in F
+    assert F.position(Transf1.make([0, 1, 2])) == S.position(
+        Transf1.make([0, 1, 2])
+    )
+
+    # The frozen copy does not depend on S
+    del S
+    assert sorted(F) == sorted(
+        Transf1.make(list(x)) for x in permutations(range(3))
+    )
+
+
+def test_froidure_pin_batched_lookups():
+    ReportGuard(False)
+    S = FroidurePin([Transf1.make([1, 0, 2]), Transf1.make([1, 2, 0])])
+    xs = [Transf1.make(list(x)) for x in permutations(range(3))]
+    xs.insert(2, Transf1.make([0, 0, 1]))
+    expected = [S.position(x) for x in xs]
+    assert expected[2] == UNDEFINED
+    assert expected.count(UNDEFINED) == 1
+
+    for ys in (xs, ElementArray(xs)):
+        for threads in (1, 2, 16):
+            assert list(S.positions(ys, threads)) == expected
+            assert list(S.contains(ys, threads)) == [
+                i != UNDEFINED for i in expected
+            ]
+            sorted_pos = list(S.sorted_positions(ys, threads))
+            assert sorted_pos[2] == UNDEFINED
+            assert sorted(sorted_pos[:2] + sorted_pos[3:]) == list(range(6))
+            F = S.freeze()
+            assert list(F.positions(ys, threads)) == expected
+
+    # Only enumerates as far as necessary
+    gens = [
+        Transf1.make([1, 2, 3, 4, 5, 0]),
+        Transf1.make([1, 0, 2, 3, 4, 5]),
+        Transf1.make([0, 0, 2, 3, 4, 5]),
+    ]
+    S = FroidurePin(gens)
+    xs = [gens[1], gens[0] * gens[2], gens[2] * gens[0] * gens[0]]
+    assert list(S.positions(xs, 2)) == [S.position(x) for x in xs]
+    assert S.contains(xs, 2).all()
+    assert not S.finished()
+    assert S.size() == 6 ** 6
+
+    # Elements of a different degree are not elements
+    assert list(S.positions([Transf1.make([0, 1, 2, 3])])) == [UNDEFINED]
+
+    with pytest.raises(RuntimeError):
+        S.positions([Bipartition.make([0, 1, 0, 1])])
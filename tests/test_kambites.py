@@ -0,0 +1,63 @@
+# -*- coding: utf-8 -*-
+# pylint: disable=no-name-in-module, missing-function-docstring
+# pylint: disable=missing-class-docstring, invalid-name
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+"""
+This module contains some tests for Kambites.
+"""
+
+import unittest
+
+from fpsemi_intf import check_validation, check_converters
+from libsemigroups_pybind11 import ReportGuard, Kambites, POSITIVE_INFINITY
+
+
+class TestKambites(unittest.TestCase):
+    def test_validation(self):
+        check_validation(self, Kambites)
+
+    def test_converters(self):
+        check_converters(self, Kambites)
+
+    def test_small_overlap(self):
+        ReportGuard(False)
+        k = Kambites()
+        k.set_alphabet("abcdefg")
+        k.add_rule("abcd", "efg")
+        self.assertEqual(k.number_of_rules(), 1)
+        self.assertEqual(list(k.rules()), [("abcd", "efg")])
+        self.assertGreaterEqual(k.small_overlap_class(), 4)
+        self.assertEqual(k.size(), POSITIVE_INFINITY)
+
+        self.assertTrue(k.equal_to("abcd", "efg"))
+        self.assertTrue(k.equal_to("aabcdd", "aefgd"))
+        self.assertFalse(k.equal_to("abcd", "abc"))
+        self.assertTrue(k.equal_to([0, 1, 2, 3], [4, 5, 6]))
+        # The normal forms are lexicographically least, not short-lex least
+        self.assertEqual(k.normal_form("abcdabcd"), "abcdabcd")
+        self.assertEqual(k.normal_form("efgefg"), "abcdabcd")
+        self.assertEqual(k.normal_form([4, 5, 6]), [0, 1, 2, 3])
+        self.assertEqual(k.normal_form("aefgd"), "aabcdd")
+
+        w = "efg" * 10000
+        self.assertEqual(k.normal_form(w), "abcd" * 10000)
+
+        with self.assertRaises(RuntimeError):
+            k.equal_to("abcd", "z")
+
+    def test_not_small_overlap(self):
+        ReportGuard(False)
+        k = Kambites()
+        k.set_alphabet("ab")
+        k.add_rule("ab", "ba")
+        self.assertLess(k.small_overlap_class(), 4)
+        with self.assertRaises(RuntimeError):
+            k.equal_to("ab", "ba")
+        with self.assertRaises(RuntimeError):
+            k.size()
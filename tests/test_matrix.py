@@ -12,6 +12,9 @@
 This module contains some tests for matrices.
 """
 
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy
 import pytest
 
 from _libsemigroups_pybind11 import (
@@ -29,6 +32,12 @@ from libsemigroups_pybind11 import (  # pylint: disable=unused-import
     Matrix,
     MatrixKind,
 )
+from libsemigroups_pybind11.matrix import (
+    make,
+    make_identity,
+    product,
+    products,
+)
 
 
 @pytest.fixture
@@ -163,7 +172,259 @@ def test_rows(matrix_types):
         ]
 
 
+def test_row_views(matrix_types):
+    for T in matrix_types:
+        x = make_mat(T, [[0, 1, 1], [1, 0, 1], [1, 1, 1]])
+        r = x.row(1)
+        assert len(r) == 3
+        assert list(r) == [x[1, 0], x[1, 1], x[1, 2]]
+        assert r[2] == x[1, 2]
+        with pytest.raises(IndexError):
+            r[3]  # pylint: disable=pointless-statement
+        with pytest.raises(IndexError):
+            x.row(3)
+
+        assert r == x.row(1)
+        assert r != x.row(0)
+        assert x.rows() == [x.row(0), x.row(1), x.row(2)]
+        assert (x.row(0) < x.row(1)) == (list(x.row(0)) < list(x.row(1)))
+
+        a = numpy.asarray(r)
+        assert a.shape == (3,)
+        assert list(a) == list(r)
+
+        # The row view keeps the matrix alive
+        rows = make_mat(T, [[0, 1], [1, 1]]).rows()
+        assert [len(r) for r in rows] == [2, 2]
+
+        if T is ProjMaxPlusMat:
+            continue
+        assert T(r) == make_mat(T, [[1, 0, 1]])
+        assert T(r).number_of_rows() == 1
+        assert x.row(0) + x.row(1) == T(x.row(0)) + T(x.row(1))
+        with pytest.raises(RuntimeError):
+            x.row(0) + make_mat(T, [[0, 1]]).row(0)
+
+
+def test_products(matrix_types):
+    for T in matrix_types:
+        xs = [
+            make_mat(T, [[0, 1, 0], [1, 0, 0], [0, 1, 1]]),
+            make_mat(T, [[1, 1, 0], [0, 0, 1], [1, 0, 0]]),
+            make_mat(T, [[0, 0, 1], [0, 1, 0], [1, 1, 1]]),
+        ] * 7
+        ys = list(reversed(xs))
+        expected = [x * y for x, y in zip(xs, ys)]
+        assert products(xs, ys) == expected
+        assert products(xs, ys, 4) == expected
+        assert products([], []) == []
+
+        expected = xs[0]
+        for x in xs[1:]:
+            expected = expected * x
+        for n in range(1, 6):
+            assert product(xs, n) == expected
+        assert product(xs, 100) == expected
+        assert product(xs[:1], 2) == xs[0]
+
+        with pytest.raises(ValueError):
+            product([])
+        with pytest.raises(RuntimeError):
+            products(xs, ys[1:])
+        with pytest.raises(RuntimeError):
+            product(xs + [make_mat(T, 2, 2)])
+        with pytest.raises(RuntimeError):
+            product([make_mat(T, [[0, 1]])])
+
+
+def test_pow(matrix_types):
+    for T in matrix_types:
+        x = make_mat(T, [[0, 1, 0], [1, 0, 1], [0, 1, 1]])
+        y = make_id_mat(T, 3)
+        for k in range(20):
+            assert x.pow(k) == y
+            assert x ** k == y
+            y = y * x
+        with pytest.raises(RuntimeError):
+            x.pow(-1)
+        with pytest.raises(RuntimeError):
+            make_mat(T, [[0, 1]]).pow(2)
+
+    x = IntMat([[1, 1], [1, 0]])
+    assert x.pow(10) == IntMat([[89, 55], [55, 34]])
+    with pytest.raises(RuntimeError):
+        x.pow(2 ** 64)
+
+    # Matrices with compile-time dimensions
+    x = Matrix(MatrixKind.Integer, [[1, 1], [1, 0]])
+    assert type(x).__name__ == "IntMat2"
+    assert x.pow(10) == IntMat([[89, 55], [55, 34]])
+    with pytest.raises(RuntimeError):
+        x.pow(2 ** 64)
+    for n in range(2, 7):
+        rows = [[int(j == i + 1) for j in range(n)] for i in range(n)]
+        x = Matrix(MatrixKind.Boolean, rows)
+        assert type(x).__name__ == f"BMat{n}"
+        assert x ** (2 ** 64) == x ** n
+
+
+def test_index_and_period():
+    for x in (
+        BMat([[0, 1, 0], [0, 0, 1], [1, 0, 0]]),
+        MaxPlusTruncMat(11, [[0, 1, 0], [1, 0, 1], [0, 1, 1]]),
+        MinPlusTruncMat(11, [[0, 1, 0], [1, 0, 1], [0, 1, 1]]),
+        NTPMat(5, 7, [[0, 1, 0], [1, 0, 1], [0, 1, 1]]),
+    ):
+        i, p = x.index_and_period()
+        assert i >= 1 and p >= 1
+        assert x ** (i + p) == x ** i
+        for k in range(1, i + p):
+            assert (x ** (k + p) == x ** k) == (k >= i)
+        k = 2 ** 100 + 3
+        assert x ** k == x ** (i + (k - i) % p)
+
+    x = BMat([[0, 1, 0], [0, 0, 1], [1, 0, 0]])
+    assert x.index_and_period() == (1, 3)
+    assert x ** (3 * 2 ** 70 + 1) == x
+
+    # Matrices with compile-time dimensions
+    for n in range(2, 7):
+        rows = [[int(j == (i + 1) % n) for j in range(n)] for i in range(n)]
+        x = Matrix(MatrixKind.Boolean, rows)
+        assert type(x).__name__ == f"BMat{n}"
+        assert x.index_and_period() == BMat(rows).index_and_period()
+        assert x.index_and_period() == (1, n)
+        assert x ** (n * 2 ** 70 + 1) == x
+
+
+def test_static_dimensions():
+    for kind, T in (
+        (MatrixKind.Boolean, BMat),
+        (MatrixKind.Integer, IntMat),
+        (MatrixKind.MaxPlus, MaxPlusMat),
+        (MatrixKind.MinPlus, MinPlusMat),
+    ):
+        for n in range(1, 9):
+            rows = [[(i + j) % 2 for j in range(n)] for i in range(n)]
+            x = Matrix(kind, rows)
+            y = T(rows)
+            if 2 <= n <= 6:
+                assert type(x).__name__ == T.__name__ + str(n)
+            else:
+                assert type(x) is T
+            assert x == y
+            assert y == x
+            assert not x != y
+            assert x * x == y * y
+            assert x.pow(3) == y.pow(3)
+            assert Matrix(kind, x) == x
+            assert type(Matrix(kind, x)) is type(x)
+            assert eval(repr(x)) == x  # pylint: disable=eval-used
+            assert type(Matrix(kind, numpy.array(rows))) is type(x)
+            assert type(Matrix(kind, n, n)) is type(x)
+            assert make_identity(kind, n) == T.make_identity(n)
+            assert type(make_identity(kind, n)) is type(x)
+            assert type(make(kind, rows)) is type(x)
+            assert make(kind, rows) * x == x * x
+            assert list(x.row(0)) == list(y.row(0))
+            assert x.to_numpy().tolist() == y.to_numpy().tolist()
+            assert numpy.asarray(x).tolist() == rows
+            assert numpy.asarray(x.row(0)).tolist() == rows[0]
+            if 2 <= n <= 6:
+                # The entries of static matrices are not copied
+                assert not numpy.asarray(x).flags.writeable
+                assert not numpy.asarray(x.row(0)).flags.writeable
+
+        x = Matrix(kind, [[0, 1], [1, 0]])
+        assert type(Matrix(kind, [[0, 1, 0], [1, 0, 1]])) is T
+        with pytest.raises(RuntimeError):
+            type(x)([[0, 1, 0], [1, 0, 0], [0, 0, 1]])
+        with pytest.raises(RuntimeError):
+            type(x)([[0, 1], [1]])
+        with pytest.raises(RuntimeError):
+            type(x)(3, 3)
+        with pytest.raises(RuntimeError):
+            type(x).make_identity(3)
+        with pytest.raises(TypeError):
+            x * T([[0, 1], [1, 0]])  # pylint: disable=expression-not-assigned
+        other = (
+            MatrixKind.Integer
+            if kind == MatrixKind.Boolean
+            else MatrixKind.Boolean
+        )
+        with pytest.raises(TypeError):
+            Matrix(other, x)
+        with pytest.raises(TypeError):
+            Matrix(MatrixKind.NTP, x)
+    with pytest.raises(RuntimeError):
+        make(MatrixKind.Boolean, [[0, 2], [1, 0]])
+
+
+def test_semirings_threads():
+    def construct(i):
+        threshold, period = i % 13, i % 7 + 1
+        return (
+            MaxPlusTruncMat(threshold, [[0, 1], [1, 0]]),
+            MinPlusTruncMat(threshold, [[0, 1], [1, 0]]),
+            NTPMat(threshold, period, [[0, 1], [1, 0]]),
+        )
+
+    with ThreadPoolExecutor(max_workers=8) as executor:
+        results = list(executor.map(construct, range(1000)))
+    for i, result in enumerate(results):
+        assert result == construct(i)
+        assert repr(result[0]).startswith(
+            f"Matrix(MatrixKind.MaxPlusTrunc, {i % 13},"
+        )
+        assert repr(result[2]).startswith(
+            f"Matrix(MatrixKind.NTP, {i % 13}, {i % 7 + 1},"
+        )
+
+
 def test_repr(matrix_types):
     for T in matrix_types:
         x = make_mat(T, [[0, 1], [1, 0]])
         assert eval(str(x)) == x  # pylint: disable=eval-used
+
+
+def test_numpy(matrix_types):
+    for T in matrix_types:
+        entries = [[0, 1, 1], [1, 0, 1], [1, 1, 1]]
+        x = make_mat(T, entries)
+        assert make_mat(T, numpy.array(entries)) == x
+        assert make_mat(T, numpy.array(entries, dtype="int32")) == x
+        assert make_mat(T, numpy.array(entries, dtype=float)) == x
+
+        y = make_mat(T, [[0, 1], [1, 0], [1, 1]])
+        assert make_mat(T, numpy.array([[0, 1, 1], [1, 0, 1]]).T) == y
+        assert x.to_numpy().shape == (3, 3)
+        assert y.to_numpy().shape == (3, 2)
+        assert make_mat(T, y.to_numpy()) == y
+        assert make_mat(T, x.to_numpy()) == x
+
+        # The entries of a dynamic matrix are copied, since swap can free
+        # their storage
+        a = numpy.asarray(y)
+        assert a.shape == (3, 2)
+        assert (a == y.to_numpy()).all()
+        entries = y.to_numpy().tolist()
+        z = make_mat(T, [[1, 1], [1, 1], [0, 0]])
+        y.swap(z)
+        del z
+        assert a.tolist() == entries
+        assert numpy.asarray(y, dtype=float).dtype == float
+
+        with pytest.raises(RuntimeError):
+            make_mat(T, numpy.array([0, 1, 1]))
+        # Entries are not silently truncated or wrapped
+        with pytest.raises(RuntimeError):
+            make_mat(T, numpy.array([[0.5, 1], [1, 0]]))
+        with pytest.raises(RuntimeError):
+            make_mat(T, numpy.array([[numpy.nan, 1], [1, 0]]))
+        with pytest.raises(TypeError):
+            make_mat(T, numpy.array([["0", "1"], ["1", "0"]]))
+
+    for x, dtype in ((2**63, "uint64"), (2**64 - 1, "uint64"), (1e30, float)):
+        with pytest.raises(RuntimeError):
+            IntMat(numpy.array([[x, 0], [0, 0]], dtype=dtype))
+    assert IntMat(numpy.array([[-(2**63), 0], [0, 0]]))[0, 0] == -(2**63)
@@ -0,0 +1,109 @@
+# -*- coding: utf-8 -*-
+# pylint: disable=no-name-in-module, missing-function-docstring
+# pylint: disable=missing-class-docstring, invalid-name
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+"""
+This module contains some tests for PackedBipartition.
+"""
+
+from random import Random
+
+import pytest
+
+from libsemigroups_pybind11 import (
+    Bipartition,
+    FroidurePin,
+    PackedBipartition,
+    ReportGuard,
+)
+
+
+def random_lookup(n, rng, k):
+    blocks, lookup = {}, []
+    for _ in range(2 * n):
+        b = rng.randrange(k)
+        lookup.append(blocks.setdefault(b, len(blocks)))
+    return lookup
+
+
+def test_packed_bipart_constructors():
+    x = PackedBipartition([0, 1, 0, 2, 3, 1, 2, 2, 3, 4, 0, 1, 2, 3, 4, 5])
+    assert x.degree() == 8
+    assert x.number_of_blocks() == 6
+    assert x.number_of_left_blocks() == 4
+    assert x.number_of_right_blocks() == 6
+    assert x.rank() == 4
+    transverse = [True, True, True, True, False, False]
+    assert [x.is_transverse_block(i) for i in range(6)] == transverse
+    assert x[3] == 2 and x[15] == 5
+    assert PackedBipartition(x) == x
+    assert x.to_bipartition() == Bipartition.make(x.lookup())
+    assert PackedBipartition(x.to_bipartition()) == x
+    # pylint: disable=eval-used
+    assert eval(repr(x)) == x
+    assert eval(repr(PackedBipartition())) == PackedBipartition()
+
+    # The blocks are renumbered in the order in which they first occur
+    assert PackedBipartition([7, 3, 3, 7]).lookup() == [0, 1, 1, 0]
+    assert PackedBipartition([7, 3, 3, 7]) == PackedBipartition([0, 1, 1, 0])
+    assert PackedBipartition.identity(32).degree() == 32
+
+    with pytest.raises(RuntimeError):
+        PackedBipartition([0, 1, 2])
+    with pytest.raises(RuntimeError):
+        PackedBipartition(list(range(66)))
+    with pytest.raises(RuntimeError):
+        PackedBipartition(Bipartition.make_identity(33))
+    with pytest.raises(RuntimeError):
+        x[16]  # pylint: disable=pointless-statement
+    with pytest.raises(RuntimeError):
+        x.is_transverse_block(6)
+
+
+def test_packed_bipart_products():
+    rng = Random(1)
+    for n in (1, 2, 3, 7, 8, 31, 32):
+        for k in (1, 2, n, 2 * n):
+            a, b = random_lookup(n, rng, k), random_lookup(n, rng, k)
+            x, y = PackedBipartition(a), PackedBipartition(b)
+            expected = Bipartition.make(a) * Bipartition.make(b)
+            assert x * y == PackedBipartition(expected)
+            assert (x * y).to_bipartition() == expected
+            assert (x * y).rank() == expected.rank()
+            z = PackedBipartition.identity(n)
+            z.product_inplace(x, y)
+            assert z == x * y
+            assert x * x.one() == x == x.one() * x
+            assert x.one() == PackedBipartition.identity(n)
+            assert (
+                PackedBipartition.identity(n).to_bipartition()
+                == Bipartition.make_identity(n)
+            )
+
+    x, y = PackedBipartition.identity(3), PackedBipartition.identity(4)
+    with pytest.raises(RuntimeError):
+        x * y  # pylint: disable=expression-not-assigned
+    with pytest.raises(RuntimeError):
+        x.product_inplace(x, PackedBipartition.identity(3))
+
+
+def test_packed_bipart_froidure_pin():
+    ReportGuard(False)
+    gens = [
+        [0, 1, 2, 1, 0, 2],
+        [0, 1, 2, 1, 2, 0],
+        [0, 1, 2, 3, 1, 2],
+        [0, 0, 1, 0, 0, 1],
+    ]
+    S = FroidurePin([PackedBipartition(x) for x in gens])
+    T = FroidurePin([Bipartition.make(x) for x in gens])
+    assert S.size() == T.size() == 203
+    assert S.number_of_idempotents() == T.number_of_idempotents()
+    assert sorted(S) == sorted(PackedBipartition(x) for x in T)
+    assert len(set(S)) == S.size()
@@ -0,0 +1,105 @@
+# -*- coding: utf-8 -*-
+# pylint: disable=no-name-in-module, missing-function-docstring
+# pylint: disable=missing-class-docstring, invalid-name
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+"""
+This module contains some tests for PackedBMat.
+"""
+
+from random import Random
+
+import pytest
+
+from _libsemigroups_pybind11 import BMat
+
+from libsemigroups_pybind11 import (
+    FroidurePin,
+    Matrix,
+    MatrixKind,
+    PackedBMat,
+    ReportGuard,
+)
+
+
+def random_rows(n, rng):
+    return [[rng.randint(0, 2) == 0 for _ in range(n)] for _ in range(n)]
+
+
+def test_packed_bmat_constructors():
+    x = PackedBMat(3)
+    assert x.degree() == 3
+    assert x.rows() == [[False] * 3] * 3
+    y = PackedBMat([[0, 1, 0], [0, 0, 1], [1, 0, 0]])
+    assert y.get(0, 1) and not y.get(0, 0)
+    assert PackedBMat(y) == y
+    assert PackedBMat(Matrix(MatrixKind.Boolean, y.rows())) == y
+    # pylint: disable=eval-used
+    assert eval(repr(y)) == y
+    assert eval(repr(PackedBMat(0))) == PackedBMat(0)
+    x.set(2, 2, True)
+    assert x.get(2, 2)
+    x.set(2, 2, False)
+    assert x == PackedBMat(3)
+
+    with pytest.raises(RuntimeError):
+        PackedBMat([[0, 1], [1]])
+    with pytest.raises(RuntimeError):
+        PackedBMat(BMat([[0, 1]]))
+    with pytest.raises(RuntimeError):
+        x.get(3, 0)
+    with pytest.raises(RuntimeError):
+        x.set(0, 3, True)
+
+
+def test_packed_bmat_products():
+    rng = Random(1)
+    for n in (1, 7, 63, 64, 65, 130):
+        a, b = random_rows(n, rng), random_rows(n, rng)
+        x, y = PackedBMat(a), PackedBMat(b)
+        expected = Matrix(MatrixKind.Boolean, a) * Matrix(MatrixKind.Boolean, b)
+        assert x * y == PackedBMat(expected)
+        z = PackedBMat(n)
+        z.product_inplace(x, y)
+        assert z == x * y
+        assert x * x.one() == x
+        assert x.one() == PackedBMat.identity(n)
+        assert x.transpose().transpose() == x
+        assert x.transpose().rows() == [list(r) for r in zip(*x.rows())]
+
+    x = PackedBMat(3)
+    with pytest.raises(RuntimeError):
+        x * PackedBMat(4)  # pylint: disable=expression-not-assigned
+    with pytest.raises(RuntimeError):
+        x.product_inplace(x, PackedBMat(3))
+
+
+def test_packed_bmat_row_col_spaces():
+    x = PackedBMat([[1, 1, 0], [1, 0, 0], [0, 1, 0]])
+    assert x.row_space_basis() == PackedBMat([[1, 0, 0], [0, 1, 0], [0, 0, 0]])
+    assert x.row_space_size() == 4
+    assert x.column_space_size() == 3
+    assert x.col_space_basis() == x.transpose().row_space_basis().transpose()
+    assert PackedBMat.identity(8).row_space_size() == 256
+    assert PackedBMat.identity(70).row_space_basis() == PackedBMat.identity(70)
+
+
+def test_packed_bmat_froidure_pin():
+    ReportGuard(False)
+    gens = [
+        [[0, 1, 0], [1, 0, 0], [0, 0, 1]],
+        [[0, 1, 0], [0, 0, 1], [1, 0, 0]],
+        [[1, 0, 0], [0, 1, 0], [1, 0, 1]],
+        [[1, 0, 0], [0, 1, 0], [0, 0, 0]],
+    ]
+    S = FroidurePin([PackedBMat(x) for x in gens])
+    T = FroidurePin([Matrix(MatrixKind.Boolean, x) for x in gens])
+    assert S.size() == T.size()
+    assert S.number_of_idempotents() == T.number_of_idempotents()
+    assert sorted(S) == sorted(PackedBMat(x) for x in T)
+    assert len(set(S)) == S.size()
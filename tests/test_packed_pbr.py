@@ -0,0 +1,81 @@
+# -*- coding: utf-8 -*-
+# pylint: disable=no-name-in-module, missing-function-docstring
+# pylint: disable=missing-class-docstring, invalid-name
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+"""
+This module contains some tests for PackedPBR.
+"""
+
+from random import Random
+
+import pytest
+
+from libsemigroups_pybind11 import FroidurePin, PackedPBR, PBR, ReportGuard
+
+
+def random_adj(n, rng, p=0.2):
+    return [[j for j in range(2 * n) if rng.random() < p] for _ in range(2 * n)]
+
+
+def test_packed_pbr_constructors():
+    x = PackedPBR(2)
+    assert x.degree() == 2
+    assert x.adjacencies() == [[], [], [], []]
+    y = PackedPBR([[1, 2], [], [3], [0, 1, 3]])
+    assert y[0] == [1, 2] and y[3] == [0, 1, 3]
+    assert PackedPBR(y) == y
+    assert PackedPBR(PBR.make([[1, 2], [], [3], [0, 1, 3]])) == y
+    assert y.to_pbr() == PBR.make([[1, 2], [], [3], [0, 1, 3]])
+    # pylint: disable=eval-used
+    assert eval(repr(y)) == y
+    assert eval(repr(PackedPBR(0))) == PackedPBR(0)
+    assert PackedPBR(32).degree() == 32
+
+    with pytest.raises(RuntimeError):
+        PackedPBR(33)
+    with pytest.raises(RuntimeError):
+        PackedPBR([[0], [1], [2]])
+    with pytest.raises(RuntimeError):
+        PackedPBR([[0, 2], [1]])
+    with pytest.raises(RuntimeError):
+        PackedPBR(PBR.make_identity(33))
+    with pytest.raises(RuntimeError):
+        y[4]  # pylint: disable=pointless-statement
+
+
+def test_packed_pbr_products():
+    rng = Random(1)
+    for n in (1, 2, 3, 4, 7, 31, 32):
+        for p in (0.05, 0.2, 0.5):
+            a, b = random_adj(n, rng, p), random_adj(n, rng, p)
+            x, y = PackedPBR(a), PackedPBR(b)
+            assert x * y == PackedPBR(PBR.make(a) * PBR.make(b))
+            z = PackedPBR(n)
+            z.product_inplace(x, y)
+            assert z == x * y
+            assert x * x.one() == x == x.one() * x
+            assert x.one() == PackedPBR.identity(n)
+            assert PackedPBR.identity(n).to_pbr() == PBR.make_identity(n)
+
+    x = PackedPBR(3)
+    with pytest.raises(RuntimeError):
+        x * PackedPBR(4)  # pylint: disable=expression-not-assigned
+    with pytest.raises(RuntimeError):
+        x.product_inplace(x, PackedPBR(3))
+
+
+def test_packed_pbr_froidure_pin():
+    ReportGuard(False)
+    gens = [[[], [0]], [[0, 1], [0]], [[1], []], [[1], [0, 1]]]
+    S = FroidurePin([PackedPBR(x) for x in gens])
+    T = FroidurePin([PBR.make(x) for x in gens])
+    assert S.size() == T.size() == 15
+    assert S.number_of_idempotents() == T.number_of_idempotents()
+    assert sorted(S) == sorted(PackedPBR(x) for x in T)
+    assert len(set(S)) == S.size()
@@ -0,0 +1,165 @@
+# -*- coding: utf-8 -*-
+# pylint: disable=no-name-in-module, missing-function-docstring
+# pylint: disable=missing-class-docstring, invalid-name
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+"""
+This module contains some tests for presentations.
+"""
+
+import pytest
+
+from libsemigroups_pybind11 import (
+    Presentation,
+    ReportGuard,
+    ToddCoxeter,
+    congruence_kind,
+    presentation,
+)
+
+
+def test_alphabet():
+    p = Presentation()
+    assert p.alphabet() == []
+    p.alphabet(3)
+    assert p.alphabet() == [0, 1, 2]
+    p.alphabet([2, 0, 1])
+    assert p.alphabet() == [2, 0, 1]
+    assert p.letter(0) == 2
+    assert p.index(2) == 0
+    with pytest.raises(RuntimeError):
+        p.alphabet([0, 0])
+
+
+def test_rules():
+    p = Presentation()
+    p.alphabet(2)
+    p.add_rule_and_check([0, 0, 0], [0])
+    p.add_rule([1, 1], [1])
+    assert p.rules == [[0, 0, 0], [0], [1, 1], [1]]
+    with pytest.raises(RuntimeError):
+        p.add_rule_and_check([0, 2], [0])
+    with pytest.raises(RuntimeError):
+        p.add_rule_and_check([0], [])
+    p.contains_empty_word(True)
+    assert p.contains_empty_word()
+    p.add_rule_and_check([0], [])
+    p.validate()
+
+    q = Presentation(p)
+    assert q.rules == p.rules
+    q.rules = []
+    assert q.rules == []
+    assert len(p.rules) == 6
+
+
+def test_alphabet_from_rules():
+    p = Presentation()
+    p.add_rule([0, 3], [3])
+    p.alphabet_from_rules()
+    assert sorted(p.alphabet()) == [0, 3]
+
+
+def test_remove_rules():
+    p = Presentation()
+    p.alphabet(2)
+    p.add_rule([0, 0], [0])
+    p.add_rule([0], [0, 0])
+    p.add_rule([1], [1])
+    p.add_rule([0, 0], [0])
+    assert presentation.length(p) == 11
+    presentation.remove_trivial_rules(p)
+    assert p.rules == [[0, 0], [0], [0], [0, 0], [0, 0], [0]]
+    presentation.remove_duplicate_rules(p)
+    assert p.rules == [[0, 0], [0]]
+
+
+def test_simplify_eliminate_generators():
+    p = Presentation()
+    p.alphabet(3)
+    p.contains_empty_word(True)
+    p.add_rule_and_check([0, 0], [0])
+    p.add_rule_and_check([0, 0], [0])
+    p.add_rule_and_check([1], [1])
+    p.add_rule_and_check([2], [0, 1])
+    p.add_rule_and_check([2, 2, 2], [1])
+
+    s = presentation.simplify(p)
+    q = s.presentation
+    assert q.alphabet() == [0, 1]
+    assert q.contains_empty_word()
+    assert q.rules == [[0, 0], [0], [0, 1, 0, 1, 0, 1], [1]]
+    assert s.to_simplified([2, 0]) == [0, 1, 0]
+    assert s.to_original([1, 0]) == [1, 0]
+    with pytest.raises(ValueError):
+        s.to_simplified([3])
+    with pytest.raises(ValueError):
+        s.to_original([2])
+    # p is not modified
+    assert p.alphabet() == [0, 1, 2]
+    assert len(p.rules) == 10
+
+
+def test_simplify_replace_common_subwords():
+    p = Presentation()
+    p.alphabet(2)
+    p.add_rule_and_check([0, 1, 1, 0, 1, 1, 0, 1, 1, 0], [1])
+    p.add_rule_and_check([1, 0, 1, 1, 0, 1, 1], [0, 0])
+
+    s = presentation.simplify(p)
+    q = s.presentation
+    assert len(q.alphabet()) == 3
+    assert presentation.length(q) < presentation.length(p)
+    assert s.to_simplified([0, 1]) == [0, 1]
+    # Every rule of the simplified presentation is, after translating back,
+    # either a rule of p or the definition of a new generator.
+    old = {
+        (tuple(p.rules[i]), tuple(p.rules[i + 1]))
+        for i in range(0, len(p.rules), 2)
+    }
+    for i in range(0, len(q.rules), 2):
+        u, v = s.to_original(q.rules[i]), s.to_original(q.rules[i + 1])
+        assert (tuple(u), tuple(v)) in old or u == v
+
+    s = presentation.simplify(p, replace_common_subwords=False)
+    assert s.presentation.rules == p.rules
+    with pytest.raises(ValueError):
+        presentation.simplify(p, min_subword_length=1)
+    with pytest.raises(ValueError):
+        presentation.simplify(p, min_subword_length=3, max_subword_length=2)
+
+    # The last rule defines the last new generator
+    q = presentation.simplify(p, max_subword_length=2).presentation
+    assert len(q.alphabet()) > 2
+    assert len(q.rules[-2]) == 2 and len(q.rules[-1]) == 1
+    assert presentation.length(q) < presentation.length(p)
+
+
+def test_simplify_todd_coxeter():
+    ReportGuard(False)
+    p = Presentation()
+    p.alphabet(3)
+    p.add_rule_and_check([0, 0, 0], [0])
+    p.add_rule_and_check([2], [0, 1])
+    p.add_rule_and_check([1, 1], [1])
+    p.add_rule_and_check([0, 1], [1, 0])
+    s = presentation.simplify(p)
+    q = s.presentation
+
+    tc1 = ToddCoxeter(congruence_kind.twosided)
+    tc1.set_number_of_generators(3)
+    for i in range(0, len(p.rules), 2):
+        tc1.add_pair(p.rules[i], p.rules[i + 1])
+
+    tc2 = ToddCoxeter(congruence_kind.twosided)
+    tc2.set_number_of_generators(len(q.alphabet()))
+    for i in range(0, len(q.rules), 2):
+        tc2.add_pair(q.rules[i], q.rules[i + 1])
+
+    assert tc1.number_of_classes() == tc2.number_of_classes() == 5
+    assert tc2.contains(s.to_simplified([2, 2]), s.to_simplified([0, 0, 1]))
@@ -0,0 +1,106 @@
+# -*- coding: utf-8 -*-
+# pylint: disable=no-name-in-module, missing-function-docstring
+# pylint: disable=missing-class-docstring, invalid-name
+
+# Copyright (c) 2021, J. D. Mitchell
+#
+# Distributed under the terms of the GPL license version 3.
+#
+# The full license is in the file LICENSE, distributed with this software.
+
+"""
+This module contains some tests for the low-index congruences algorithm.
+"""
+
+import pytest
+
+from libsemigroups_pybind11 import (
+    ReportGuard,
+    Presentation,
+    Sims1,
+    congruence_kind,
+)
+
+
+def commutative_idempotent_monoid():
+    p = Presentation()
+    p.alphabet(2)
+    p.contains_empty_word(True)
+    p.add_rule_and_check([0, 0], [0])
+    p.add_rule_and_check([1, 1], [1])
+    p.add_rule_and_check([0, 1], [1, 0])
+    return p
+
+
+def test_number_of_congruences():
+    ReportGuard(False)
+    S = Sims1(congruence_kind.right)
+    S.short_rules(commutative_idempotent_monoid())
+    assert [S.number_of_congruences(n) for n in range(1, 6)] == [
+        1,
+        4,
+        6,
+        7,
+        7,
+    ]
+    S.number_of_threads(4)
+    assert S.number_of_threads() == 4
+    assert S.number_of_congruences(4) == 7
+
+    p = Presentation()
+    p.alphabet(1)
+    p.contains_empty_word(True)
+    p.add_rule_and_check([0, 0, 0], [0])
+    S = Sims1(congruence_kind.left)
+    S.short_rules(p)
+    assert S.number_of_congruences(3) == 4
+
+
+def test_iterator_for_each_find_if():
+    ReportGuard(False)
+    S = Sims1(congruence_kind.right)
+    S.short_rules(commutative_idempotent_monoid())
+    digraphs = list(S.iterator(3))
+    assert len(digraphs) == 6
+    assert all(d.number_of_nodes() <= 3 for d in digraphs)
+
+    for nr_threads in (1, 2):
+        S.number_of_threads(nr_threads)
+        found = []
+        S.for_each(3, found.append)
+        assert len(found) == 6
+        d = S.find_if(4, lambda d: d.number_of_nodes() == 4)
+        assert d.number_of_nodes() == 4
+
+
+def test_for_each_find_if_raise():
+    ReportGuard(False)
+    S = Sims1(congruence_kind.right)
+    S.short_rules(commutative_idempotent_monoid())
+
+    def hook(d):
+        if d.number_of_nodes() == 3:
+            raise ValueError("bad digraph")
+        return d.number_of_nodes() == 4
+
+    for nr_threads in (1, 2, 4):
+        S.number_of_threads(nr_threads)
+        with pytest.raises(ValueError):
+            S.for_each(3, hook)
+        with pytest.raises(ZeroDivisionError):
+            S.find_if(4, lambda d: 1 // 0)
+        assert S.find_if(2, hook).number_of_nodes() == 0
+
+
+def test_settings():
+    S = Sims1(congruence_kind.right)
+    p = commutative_idempotent_monoid()
+    S.short_rules(p)
+    assert S.short_rules().rules == p.rules
+    e = Presentation()
+    e.alphabet(2)
+    e.contains_empty_word(True)
+    e.add_rule_and_check([0], [1])
+    S.extra(e)
+    assert S.extra().rules == e.rules
+    assert S.number_of_congruences(4) == 2
@@ -14,6 +14,10 @@ permutations.
 """
 
 import unittest
+from array import array
+from random import Random
+
+import numpy
 
 from _libsemigroups_pybind11 import (
     Transf16,
@@ -30,6 +34,8 @@ from _libsemigroups_pybind11 import (
     Perm4,
 )
 
+from libsemigroups_pybind11.transf import Transf, PPerm, Perm
+
 
 def check_identity_ops(self, T, x):
     # T.identity, operator==, and operator!=
@@ -234,6 +240,73 @@ def check_perm(self, T):
     )
 
 
+def random_images16(T, rng):
+    if T is Transf16:
+        return [rng.randrange(16) for _ in range(16)]
+    images = list(range(16))
+    rng.shuffle(images)
+    if T is PPerm16:
+        images = [x if rng.random() < 0.75 else 255 for x in images]
+    return images
+
+
+def check_batch16(self, T):
+    rng = Random(16)
+    xs = [random_images16(T, rng) for _ in range(100)]
+    ys = [random_images16(T, rng) for _ in range(100)]
+    a = numpy.array(xs, dtype=numpy.uint8)
+    b = numpy.array(ys, dtype=numpy.uint8)
+    for threads in (1, 3):
+        result = T.products(a, b, threads)
+        self.assertEqual(result.shape, (100, 16))
+        self.assertEqual(result.dtype, numpy.uint8)
+        for k in range(100):
+            self.assertEqual(
+                list(result[k]), list((T.make(xs[k]) * T.make(ys[k])).images())
+            )
+        self.assertEqual(
+            list(T.ranks(a, number_of_threads=threads)),
+            [T.make(x).rank() for x in xs],
+        )
+        if T is not Transf16:
+            result = T.inverses(a, number_of_threads=threads)
+            for k in range(100):
+                self.assertEqual(
+                    list(result[k]), list(T.make(xs[k]).inverse().images())
+                )
+
+    # Lists are converted to arrays
+    self.assertEqual(
+        list(T.products(xs[:1], ys[:1])[0]), list(T.products(a, b)[0])
+    )
+    self.assertEqual(T.products(a[:0], b[:0]).shape, (0, 16))
+
+    with self.assertRaises(RuntimeError):
+        T.products(a, b[:99])
+    with self.assertRaisesRegex(RuntimeError, r"shape \(100, 15\)"):
+        T.ranks(a[:, :15])
+    with self.assertRaisesRegex(RuntimeError, r"shape \(1600,\)"):
+        T.ranks(a.reshape(-1))
+    a[50, 3] = 16
+    with self.assertRaises(RuntimeError):
+        T.ranks(a)
+    if T is not Transf16:
+        a[50, 3], a[50, 4] = 0, 0
+        with self.assertRaises(RuntimeError):
+            T.products(a, b)
+
+
+class TestBatch16(unittest.TestCase):
+    def test_transf16(self):
+        check_batch16(self, Transf16)
+
+    def test_pperm16(self):
+        check_batch16(self, PPerm16)
+
+    def test_perm16(self):
+        check_batch16(self, Perm16)
+
+
 class TestTransf(unittest.TestCase):
     def test_transf16(self):
         check_transf(self, Transf16)
@@ -274,3 +347,117 @@ class TestPerm(unittest.TestCase):
 
     def test_perm4(self):
         check_perm(self, Perm4)
+
+
+def check_parallel4(self, T, images):
+    rng = Random(0)
+    n = len(images)
+    x, y = T.make(images), T.make(rng.sample(range(n), n))
+    xy = T.make_identity(n)
+    for number_of_threads in (1, 2, 4):
+        xy.product_inplace(x, y, number_of_threads)
+        self.assertEqual(xy, x * y)
+        self.assertEqual(x.rank(number_of_threads), x.rank())
+        self.assertEqual(
+            list(x.image(number_of_threads)),
+            sorted({i for i in images if T is not PPerm4 or i != T.undef()}),
+        )
+    with self.assertRaises(RuntimeError):
+        xy.product_inplace(x, T.make_identity(n - 1), 2)
+    with self.assertRaises(RuntimeError):
+        xy.product_inplace(xy, y, 2)
+
+
+class TestParallel4(unittest.TestCase):
+    n = 2 ** 17 + 3
+
+    def test_transf4(self):
+        rng = Random(1)
+        images = [rng.randrange(self.n) for _ in range(self.n)]
+        check_parallel4(self, Transf4, images)
+
+    def test_pperm4(self):
+        rng = Random(1)
+        images = rng.sample(range(self.n), self.n)
+        images = [x if rng.random() < 0.75 else PPerm4.undef() for x in images]
+        check_parallel4(self, PPerm4, images)
+
+    def test_perm4(self):
+        rng = Random(1)
+        check_parallel4(self, Perm4, rng.sample(range(self.n), self.n))
+
+
+class TestFromBuffer(unittest.TestCase):
+    def test_narrowest_type(self):
+        images = [1, 0, 2]
+        self.assertEqual(Transf(bytes(images)), Transf(images))
+        self.assertIsInstance(Transf(bytes(images)), Transf16)
+        images = list(range(1, 17)) + [0]
+        self.assertIsInstance(Perm(bytes(images)), Perm1)
+        self.assertEqual(Perm(bytes(images)), Perm1.make(images))
+        images = list(range(1, 300)) + [0]
+        x = Perm(numpy.array(images, dtype=numpy.uint16))
+        self.assertIsInstance(x, Perm2)
+        self.assertEqual(x, Perm2.make(images))
+        images = list(range(1, 70000)) + [0]
+        x = Transf(numpy.array(images, dtype=numpy.uint32))
+        self.assertIsInstance(x, Transf4)
+        self.assertEqual(x, Transf4.make(images))
+        x = Transf(array("q", [0] * 20))
+        self.assertIsInstance(x, Transf1)
+        self.assertEqual(x, Transf1.make([0] * 20))
+
+    def test_strided(self):
+        a = numpy.array([[1, 5], [0, 5], [2, 5]], dtype=numpy.int32)
+        self.assertEqual(Perm(a[:, 0]), Perm([1, 0, 2]))
+
+    def test_undefined(self):
+        images = [4, 7, 6] + [255] * 13
+        x = PPerm(bytes(images))
+        self.assertIsInstance(x, PPerm16)
+        self.assertEqual(x, PPerm16.make([0, 1, 2], [4, 7, 6], 16))
+        images = [4, 7, 6] + [65535] * 27
+        x = PPerm(numpy.array(images, dtype=numpy.uint16))
+        self.assertEqual(x, PPerm1.make([0, 1, 2], [4, 7, 6], 30))
+        x = PPerm(numpy.array([4, 7, 6] + [-1] * 27, dtype=numpy.int8))
+        self.assertEqual(x, PPerm1.make([0, 1, 2], [4, 7, 6], 30))
+
+    def test_max_value_is_an_image(self):
+        # The maximum value of the type of the entries is only undefined for
+        # partial perms.
+        x = Transf(bytes([255] * 300))
+        self.assertIsInstance(x, Transf2)
+        self.assertEqual(x, Transf2.make([255] * 300))
+        images = list(range(1, 256)) + [0]
+        x = Perm(bytes(images))
+        self.assertIsInstance(x, Perm1)
+        self.assertEqual(x, Perm1.make(images))
+        x = Transf(numpy.array([65535] * 70000, dtype=numpy.uint16))
+        self.assertEqual(x, Transf4.make([65535] * 70000))
+        x = Transf(numpy.array([127] * 200, dtype=numpy.int8))
+        self.assertEqual(x, Transf1.make([127] * 200))
+
+    def test_exceptions(self):
+        with self.assertRaises(RuntimeError):
+            Transf(bytes([0, 3, 1]))
+        with self.assertRaises(RuntimeError):
+            Transf(numpy.array([0, -1, 1], dtype=numpy.int8))
+        with self.assertRaises(RuntimeError):
+            Perm(numpy.array([0, -1, 1], dtype=numpy.int64))
+        with self.assertRaises(RuntimeError):
+            PPerm(bytes([0, 0, 1]))
+        with self.assertRaises(RuntimeError):
+            Perm(bytes([0, 255, 1]))
+        with self.assertRaises(TypeError):
+            Transf(numpy.zeros((2, 2), dtype=numpy.uint8))
+        with self.assertRaises(TypeError):
+            Transf(numpy.zeros(2, dtype=numpy.float64))
+        with self.assertRaises(TypeError):
+            Transf((0, 1))
+
+    def test_list_unchanged(self):
+        images = [1, 0]
+        Transf(images)
+        PPerm(images)
+        Perm(images)
+        self.assertEqual(images, [1, 0])